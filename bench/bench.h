@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+
+namespace ndv::bench
+{
+  struct State
+  {
+    std::size_t iterations;
+    // problem size of a sized benchmark, 0 otherwise
+    std::size_t size = 0;
+    // work done by one iteration, set by the benchmark body before its loop. items default to one
+    // operation per iteration and bytes to none, in which case no bandwidth is reported
+    std::size_t items = 1;
+    std::size_t bytes = 0;
+  };
+
+  using BenchFn = void (*)(State&);
+
+  struct Benchmark
+  {
+    const char* name;
+    BenchFn fn;
+    std::vector<std::size_t> sizes;
+  };
+
+  struct Result
+  {
+    std::size_t iterations;
+    double ns_per_op;
+    double items_per_second;
+    double bytes_per_second;
+  };
+
+  inline std::vector<Benchmark>& registry()
+  {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  struct Registrar
+  {
+    Registrar(const char* name, BenchFn fn) { registry().push_back({name, fn, {}}); }
+    Registrar(const char* name, BenchFn fn, std::initializer_list<std::size_t> sizes) { registry().push_back({name, fn, sizes}); }
+  };
+
+  // keeps the compiler from discarding a value that is never read
+  template<typename T>
+  inline void do_not_optimize(const T& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+  }
+
+  // doubles the iteration count until a run takes at least min_time, then reports the time per
+  // iteration and the item and byte rates the benchmark declared for one iteration
+  inline Result measure(BenchFn fn, std::size_t size = 0, double min_time = 0.1)
+  {
+    using clock = std::chrono::steady_clock;
+    for (std::size_t n = 1;; n *= 2)
+    {
+      State state{n, size};
+      const auto start = clock::now();
+      fn(state);
+      const double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+      if (elapsed >= min_time)
+      {
+        const double per_op = elapsed / n;
+        return {n, per_op * 1e9, state.items / per_op, state.bytes / per_op};
+      }
+    }
+  }
+}
+
+#define NDV_BENCH_CAT_(a, b) a##b
+#define NDV_BENCH_CAT(a, b) NDV_BENCH_CAT_(a, b)
+#define NDV_BENCHMARK(name) \
+  static void NDV_BENCH_CAT(ndv_bench_, __LINE__)(ndv::bench::State&); \
+  static ndv::bench::Registrar NDV_BENCH_CAT(ndv_bench_reg_, __LINE__)(name, &NDV_BENCH_CAT(ndv_bench_, __LINE__)); \
+  static void NDV_BENCH_CAT(ndv_bench_, __LINE__)(ndv::bench::State& state)
+
+// runs once per listed size, which the body reads from state.size
+#define NDV_BENCHMARK_SIZES(name, ...) \
+  static void NDV_BENCH_CAT(ndv_bench_, __LINE__)(ndv::bench::State&); \
+  static ndv::bench::Registrar NDV_BENCH_CAT(ndv_bench_reg_, __LINE__)(name, &NDV_BENCH_CAT(ndv_bench_, __LINE__), {__VA_ARGS__}); \
+  static void NDV_BENCH_CAT(ndv_bench_, __LINE__)(ndv::bench::State& state)
@@ -0,0 +1,107 @@
+#include "bench.h"
+
+#include <ndv/bounds.h>
+#include <ndv/quat.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  struct Objects
+  {
+    std::vector<Mat4> matrices;
+    std::vector<AABB3> boxes;
+    std::vector<Sphere3> spheres;
+
+    explicit Objects(std::size_t n)
+    {
+      for (std::size_t i = 0; i < n; i++)
+      {
+        Mat4 m = to_mat4(Quat::axis_angle(Vec3(1, float(i % 3), -0.5f), 0.01f * i));
+        m.row[0].w = float(i % 100);
+        m.row[2].w = -float(i % 37);
+        matrices.push_back(m);
+        boxes.emplace_back(Vec3(-1, -2, -0.5f), Vec3(1, 2, 0.5f + 0.01f * (i % 10)));
+        spheres.emplace_back(Vec3(0, 1, 0), 1.0f + 0.01f * (i % 10));
+      }
+    }
+  };
+
+  // the usual approach: all 8 corners through the matrix, then re-bounded
+  AABB3 transform_corners(const Mat4& m, const AABB3& box)
+  {
+    AABB3 result = AABB3::empty;
+    for (int k = 0; k < 8; k++)
+    {
+      const Vec4 p = m * Vec4((k & 1) ? box.max.x : box.min.x, (k & 2) ? box.max.y : box.min.y, (k & 4) ? box.max.z : box.min.z, 1);
+      result = merge(result, Vec3(p.x, p.y, p.z));
+    }
+    return result;
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform aabb (8 corners)", 4096)
+{
+  Objects objects(state.size);
+  std::vector<AABB3> out(state.size);
+  state.items = state.size;
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    for (std::size_t i = 0; i < state.size; i++)
+      out[i] = transform_corners(objects.matrices[i], objects.boxes[i]);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform aabb (arvo)", 4096)
+{
+  Objects objects(state.size);
+  std::vector<AABB3> out(state.size);
+  state.items = state.size;
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    for (std::size_t i = 0; i < state.size; i++)
+      out[i] = transform(objects.matrices[i], objects.boxes[i]);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform_bounds aabb (per object)", 4096)
+{
+  Objects objects(state.size);
+  std::vector<AABB3> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * (sizeof(Mat4) + 2 * sizeof(AABB3));
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    transform_bounds(objects.matrices, objects.boxes, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform_bounds aabb (one matrix)", 4096)
+{
+  Objects objects(state.size);
+  std::vector<AABB3> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 2 * sizeof(AABB3);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    transform_bounds(objects.matrices[1], objects.boxes, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform_bounds sphere (per object)", 4096)
+{
+  Objects objects(state.size);
+  std::vector<Sphere3> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * (sizeof(Mat4) + 2 * sizeof(Sphere3));
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    transform_bounds(objects.matrices, objects.spheres, out);
+    bench::do_not_optimize(out.data());
+  }
+}
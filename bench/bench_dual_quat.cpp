@@ -0,0 +1,61 @@
+#include "bench.h"
+
+#include <ndv/dual_quat.h>
+using namespace ndv;
+
+NDV_BENCHMARK("dualquat * dualquat")
+{
+  DualQuat a(Quat::axis_angle(Vec3(0, 1, 1), 0.5f), Vec3(1, 2, 3));
+  DualQuat b(Quat::axis_angle(Vec3(1, 0, 0), -1.25f), Vec3(-1, 0, 2));
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    DualQuat r = a * b;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("dualquat transform point")
+{
+  DualQuat a(Quat::axis_angle(Vec3(0, 1, 1), 0.5f), Vec3(1, 2, 3));
+  Vec3 p(1, 2, 3);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(p);
+    Vec3 r = transform_point(a, p);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("dualquat blend")
+{
+  DualQuat a(Quat::axis_angle(Vec3(0, 1, 1), 0.5f), Vec3(1, 2, 3));
+  DualQuat b(Quat::axis_angle(Vec3(1, 0, 0), -1.25f), Vec3(-1, 0, 2));
+  float t = 0.3f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    bench::do_not_optimize(t);
+    DualQuat r = blend(a, b, t);
+    bench::do_not_optimize(r);
+  }
+}
+
+// the matrix equivalent of a blend, which is not rigid
+NDV_BENCHMARK("dualquat blend (mat4 lerp)")
+{
+  Mat4 a = to_mat4(DualQuat(Quat::axis_angle(Vec3(0, 1, 1), 0.5f), Vec3(1, 2, 3)));
+  Mat4 b = to_mat4(DualQuat(Quat::axis_angle(Vec3(1, 0, 0), -1.25f), Vec3(-1, 0, 2)));
+  float t = 0.3f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    bench::do_not_optimize(t);
+    Mat4 r = a * (1 - t) + b * t;
+    bench::do_not_optimize(r);
+  }
+}
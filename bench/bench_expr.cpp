@@ -0,0 +1,79 @@
+#include "bench.h"
+
+#include <ndv/expr.h>
+using namespace ndv;
+
+namespace
+{
+  using Vec256 = Vec<256, float>;
+  using Mat16d = Mat<16, 16, double>;
+
+  Vec256 make_vec(float seed)
+  {
+    Vec256 v;
+    for (int i = 0; i < 256; i++)
+      v[i] = seed + 0.25f * i;
+    return v;
+  }
+
+  Mat16d make_mat(double seed)
+  {
+    Mat16d m;
+    for (int r = 0; r < 16; r++)
+      for (int c = 0; c < 16; c++)
+        m.row[r][c] = seed + 0.25 * (r * 16 + c);
+    return m;
+  }
+}
+
+NDV_BENCHMARK("vec256 a + b * s - c (eager)")
+{
+  Vec256 a = make_vec(0.5f), b = make_vec(-0.25f), c = make_vec(2.0f);
+  float s = 1.5f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(s);
+    Vec256 r = a + b * s - c;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("vec256 a + b * s - c (lazy)")
+{
+  Vec256 a = make_vec(0.5f), b = make_vec(-0.25f), c = make_vec(2.0f);
+  float s = 1.5f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(s);
+    Vec256 r = lazy(a) + lazy(b) * s - c;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat16d a * s + b - c (eager)")
+{
+  Mat16d a = make_mat(0.5), b = make_mat(-0.25), c = make_mat(2.0);
+  double s = 1.5;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(s);
+    Mat16d r = a * s + b - c;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat16d a * s + b - c (lazy)")
+{
+  Mat16d a = make_mat(0.5), b = make_mat(-0.25), c = make_mat(2.0);
+  double s = 1.5;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(s);
+    Mat16d r = lazy(a) * s + b - c;
+    bench::do_not_optimize(r);
+  }
+}
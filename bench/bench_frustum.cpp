@@ -0,0 +1,91 @@
+#include "bench.h"
+
+#include <ndv/frustum.h>
+using namespace ndv;
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+  struct Scene
+  {
+    Frustum<float> frustum;
+    VecArray<3, float> centers, extents;
+    std::vector<float> radii;
+
+    explicit Scene(std::size_t n) : frustum(perspective(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f)), centers(n), extents(n, Vec3(1.0f)), radii(n)
+    {
+      for (std::size_t i = 0; i < n; i++)
+      {
+        centers[i] = Vec3(100 * std::sin(0.37f * i), 100 * std::cos(0.11f * i), -120 * std::abs(std::sin(0.05f * i)) + 10);
+        radii[i] = 1.0f + float(i % 4);
+      }
+    }
+  };
+
+  void declare_work(bench::State& state)
+  {
+    state.items = state.size;
+    state.bytes = state.size * 4 * sizeof(float);
+  }
+}
+
+NDV_BENCHMARK_SIZES("cull spheres (per object)", 4096, 131072)
+{
+  Scene scene(state.size);
+  std::vector<std::uint32_t> indices(state.size);
+  declare_work(state);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < state.size; i++)
+    {
+      if (intersects_sphere(scene.frustum, scene.centers[i], scene.radii[i]))
+        indices[count++] = std::uint32_t(i);
+    }
+    bench::do_not_optimize(count);
+    bench::do_not_optimize(indices.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("cull spheres (mask)", 4096, 131072)
+{
+  Scene scene(state.size);
+  std::vector<std::uint64_t> mask((state.size + 63) / 64);
+  declare_work(state);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    const std::size_t count = cull_spheres(scene.frustum, scene.centers, scene.radii, mask);
+    bench::do_not_optimize(count);
+    bench::do_not_optimize(mask.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("cull spheres (indices)", 4096, 131072)
+{
+  Scene scene(state.size);
+  std::vector<std::uint32_t> indices(state.size);
+  declare_work(state);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    const std::size_t count = cull_spheres(scene.frustum, scene.centers, scene.radii, indices);
+    bench::do_not_optimize(count);
+    bench::do_not_optimize(indices.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("cull boxes (indices)", 4096, 131072)
+{
+  Scene scene(state.size);
+  std::vector<std::uint32_t> indices(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 6 * sizeof(float);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    const std::size_t count = cull_boxes(scene.frustum, scene.centers, scene.extents, indices);
+    bench::do_not_optimize(count);
+    bench::do_not_optimize(indices.data());
+  }
+}
@@ -0,0 +1,77 @@
+#include "bench.h"
+
+#include <ndv/hierarchy.h>
+using namespace ndv;
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+  // wide near the top and chains further down, like a scene of characters and props
+  void build(TransformHierarchy& hierarchy, std::size_t n)
+  {
+    hierarchy.reserve(n);
+    hierarchy.add(TransformHierarchy::no_parent, translate(Vec3(1, 0, 0)));
+    for (std::uint32_t i = 1; i < n; i++)
+    {
+      const std::uint32_t parent = (i % 4 == 0) ? i / 4 : i - 1;
+      hierarchy.add(parent, translate(Vec3(0.01f * (i % 13), 0.5f, 0)) * rotate(Vec3(0.0f, 1.0f, 0.0f), 0.001f * i));
+    }
+    hierarchy.update();
+  }
+}
+
+// every node recomputed every frame, the loop the hierarchy replaces
+NDV_BENCHMARK_SIZES("world matrices (all nodes)", 262144)
+{
+  TransformHierarchy hierarchy;
+  build(hierarchy, state.size);
+  std::vector<Mat4> world(state.size);
+  state.items = state.size;
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    world[0] = hierarchy.local(0);
+    for (std::uint32_t i = 1; i < state.size; i++)
+      world[i] = world[hierarchy.parent(i)] * hierarchy.local(i);
+    bench::do_not_optimize(world.data());
+  }
+}
+
+// 1% of the nodes move, spread over the hierarchy
+NDV_BENCHMARK_SIZES("hierarchy update (1% moved)", 262144)
+{
+  TransformHierarchy hierarchy;
+  build(hierarchy, state.size);
+  state.items = state.size;
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    for (std::uint32_t i = 1000 + iter % 100; i < state.size; i += 100)
+      hierarchy.set_local(i, hierarchy.local(i));
+    bench::do_not_optimize(hierarchy.update());
+  }
+}
+
+NDV_BENCHMARK_SIZES("hierarchy update (all moved)", 262144)
+{
+  TransformHierarchy hierarchy;
+  build(hierarchy, state.size);
+  state.items = state.size;
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    hierarchy.set_local(0, hierarchy.local(0));
+    bench::do_not_optimize(hierarchy.update());
+  }
+}
+
+NDV_BENCHMARK_SIZES("hierarchy update (all moved, par)", 262144)
+{
+  TransformHierarchy hierarchy;
+  build(hierarchy, state.size);
+  state.items = state.size;
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    hierarchy.set_local(0, hierarchy.local(0));
+    bench::do_not_optimize(hierarchy.update(par));
+  }
+}
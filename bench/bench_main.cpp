@@ -0,0 +1,114 @@
+#include "bench.h"
+
+#include <ndv/simd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+  enum class Format { table, csv, json };
+
+  const char* simd_config()
+  {
+#if defined(NDV_SIMD_AVX) && defined(NDV_SIMD_FMA)
+    return "avx+fma";
+#elif defined(NDV_SIMD_AVX)
+    return "avx";
+#elif defined(NDV_SIMD_SSE4_1)
+    return "sse4.1";
+#elif defined(NDV_SIMD_SSE)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+  }
+
+  void usage(const char* exe)
+  {
+    std::fprintf(stderr,
+      "usage: %s [filter] [--format=table|csv|json] [--min-time=seconds]\n"
+      "  filter      only run benchmarks whose name contains this string\n"
+      "  --format    table (default), csv, or json for tracking results across builds\n"
+      "  --min-time  minimum measured time per benchmark, 0.1 s by default\n",
+      exe);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const char* filter = nullptr;
+  Format format = Format::table;
+  double min_time = 0.1;
+
+  for (int i = 1; i < argc; i++)
+  {
+    const char* arg = argv[i];
+    if (std::strcmp(arg, "--format=table") == 0)
+      format = Format::table;
+    else if (std::strcmp(arg, "--format=csv") == 0)
+      format = Format::csv;
+    else if (std::strcmp(arg, "--format=json") == 0)
+      format = Format::json;
+    else if (std::strncmp(arg, "--min-time=", 11) == 0)
+      min_time = std::atof(arg + 11);
+    else if (arg[0] == '-' || filter)
+    {
+      usage(argv[0]);
+      return 1;
+    }
+    else
+      filter = arg;
+  }
+
+  if (format == Format::table)
+    std::printf("%-44s %12s %12s %14s %12s\n", "benchmark", "ns/op", "ns/item", "items/s", "GB/s");
+  else if (format == Format::csv)
+    std::printf("name,size,iterations,ns_per_op,ns_per_item,items_per_second,bytes_per_second\n");
+  else
+    std::printf("{\n  \"context\": {\"simd\": \"%s\"},\n  \"benchmarks\": [", simd_config());
+
+  bool first = true;
+  for (const auto& b : ndv::bench::registry())
+  {
+    if (filter && !std::strstr(b.name, filter))
+      continue;
+
+    // unsized benchmarks run once with size 0
+    const std::vector<std::size_t> sizes = b.sizes.empty() ? std::vector<std::size_t>{0} : b.sizes;
+    for (std::size_t size : sizes)
+    {
+      const ndv::bench::Result r = ndv::bench::measure(b.fn, size, min_time);
+      const double ns_per_item = 1e9 / r.items_per_second;
+      std::string name = b.name;
+      if (size)
+        name += "/" + std::to_string(size);
+
+      if (format == Format::table)
+      {
+        if (r.bytes_per_second > 0)
+          std::printf("%-44s %12.2f %12.3f %14.4g %12.2f\n", name.c_str(), r.ns_per_op, ns_per_item, r.items_per_second, r.bytes_per_second * 1e-9);
+        else
+          std::printf("%-44s %12.2f %12.3f %14.4g %12s\n", name.c_str(), r.ns_per_op, ns_per_item, r.items_per_second, "-");
+      }
+      else if (format == Format::csv)
+      {
+        std::printf("\"%s\",%zu,%zu,%.4f,%.4f,%.6g,%.6g\n",
+          b.name, size, r.iterations, r.ns_per_op, ns_per_item, r.items_per_second, r.bytes_per_second);
+      }
+      else
+      {
+        std::printf("%s\n    {\"name\": \"%s\", \"size\": %zu, \"iterations\": %zu, \"ns_per_op\": %.4f, \"ns_per_item\": %.4f, "
+          "\"items_per_second\": %.6g, \"bytes_per_second\": %.6g}",
+          first ? "" : ",", b.name, size, r.iterations, r.ns_per_op, ns_per_item, r.items_per_second, r.bytes_per_second);
+      }
+      std::fflush(stdout);
+      first = false;
+    }
+  }
+
+  if (format == Format::json)
+    std::printf("\n  ]\n}\n");
+  return 0;
+}
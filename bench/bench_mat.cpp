@@ -0,0 +1,262 @@
+#include "bench.h"
+
+#include <ndv/mat.h>
+using namespace ndv;
+
+#include <cmath>
+
+namespace
+{
+  Mat4 make_mat(float seed)
+  {
+    Mat4 m;
+    for (int r = 0; r < 4; r++)
+      for (int c = 0; c < 4; c++)
+        m[r][c] = seed + 0.25f * (r * 4 + c);
+    return m;
+  }
+
+  // the previous generic product, kept as a baseline
+  Mat4 reference_mul(const Mat4& lhs, const Mat4& rhs)
+  {
+    Mat4 result;
+    for (int r = 0; r < 4; r++)
+    {
+      for (int c = 0; c < 4; c++)
+      {
+        float val = 0;
+        for (int i = 0; i < 4; i++)
+          val += lhs[r][i] * rhs[i][c];
+        result[r][c] = val;
+      }
+    }
+    return result;
+  }
+
+  Vec4 reference_mul(const Mat4& lhs, const Vec4& rhs)
+  {
+    Vec4 result;
+    for (int r = 0; r < 4; r++)
+    {
+      float val = 0;
+      for (int c = 0; c < 4; c++)
+        val += lhs[r][c] * rhs[c];
+      result[r] = val;
+    }
+    return result;
+  }
+}
+
+NDV_BENCHMARK("mat4 * mat4 (reference)")
+{
+  Mat4 a = make_mat(0.5f), b = make_mat(-0.25f);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    Mat4 c = reference_mul(a, b);
+    bench::do_not_optimize(c);
+  }
+}
+
+NDV_BENCHMARK("mat4 * mat4")
+{
+  Mat4 a = make_mat(0.5f), b = make_mat(-0.25f);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    Mat4 c = a * b;
+    bench::do_not_optimize(c);
+  }
+}
+
+NDV_BENCHMARK("mat4 *= mat4")
+{
+  Mat4 a = Mat4::identity, b = make_mat(-0.25f) * 0.01f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(b);
+    a *= b;
+    bench::do_not_optimize(a);
+  }
+}
+
+NDV_BENCHMARK("affine3 * affine3")
+{
+  Affine3 a = to_affine(translate(Vec3(1, 2, 3)) * rotate(Vec3(0, 1, 1), 0.5f));
+  Affine3 b = to_affine(translate(Vec3(-1, 0, 2)) * rotate(Vec3(1, 0, 1), -0.3f));
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    Affine3 c = a * b;
+    bench::do_not_optimize(c);
+  }
+}
+
+NDV_BENCHMARK("mat4 * vec4 (reference)")
+{
+  Mat4 m = make_mat(0.5f);
+  Vec4 v(1, 2, 3, 4);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    bench::do_not_optimize(v);
+    Vec4 r = reference_mul(m, v);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat4 * vec4")
+{
+  Mat4 m = make_mat(0.5f);
+  Vec4 v(1, 2, 3, 4);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    bench::do_not_optimize(v);
+    Vec4 r = m * v;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat4 inverse (cofactor)")
+{
+  Mat4 m = make_mat(0.5f);
+  m[3][3] = 7.0f;
+  m[0][0] = -3.0f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Mat4 r = adjoint(m) / determinant<4, float>(m);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat4 inverse")
+{
+  Mat4 m = make_mat(0.5f);
+  m[3][3] = 7.0f;
+  m[0][0] = -3.0f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Mat4 r = inverse(m);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat4 inverse (affine)")
+{
+  Mat4 m = translate(Vec3(1, 2, 3)) * rotate(Vec3(0, 1, 1), 0.5f);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Mat4 r = inverse(m);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("affine3 inverse")
+{
+  Affine3 m = to_affine(translate(Vec3(1, 2, 3)) * rotate(Vec3(0, 1, 1), 0.5f));
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Affine3 r = inverse(m);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat4 determinant")
+{
+  Mat4 m = make_mat(0.5f);
+  m[0][0] = -3.0f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    float d = determinant(m);
+    bench::do_not_optimize(d);
+  }
+}
+
+namespace
+{
+  template<int N>
+  Mat<N, N, double> make_matd()
+  {
+    Mat<N, N, double> m;
+    for (int r = 0; r < N; r++)
+      for (int c = 0; c < N; c++)
+        m[r][c] = (r == c ? N : 0) + std::sin(1.0 + r * N + c);
+    return m;
+  }
+
+  // the previous generic inverse: adjugate and determinant by cofactor expansion
+  template<int N>
+  Mat<N, N, double> reference_inverse(const Mat<N, N, double>& m)
+  {
+    Mat<N, N, double> result;
+    for (int r = 0; r < N; r++)
+      for (int c = 0; c < N; c++)
+        result[c][r] = (1 - 2 * ((r + c) % 2)) * determinant_laplace(submatrix(m, r, c));
+    return result / determinant_laplace(m);
+  }
+}
+
+NDV_BENCHMARK("mat6d determinant (laplace)")
+{
+  Mat<6, 6, double> m = make_matd<6>();
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    double d = determinant_laplace(m);
+    bench::do_not_optimize(d);
+  }
+}
+
+NDV_BENCHMARK("mat6d determinant")
+{
+  Mat<6, 6, double> m = make_matd<6>();
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    double d = determinant(m);
+    bench::do_not_optimize(d);
+  }
+}
+
+NDV_BENCHMARK("mat6d inverse (cofactor)")
+{
+  Mat<6, 6, double> m = make_matd<6>();
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Mat<6, 6, double> r = reference_inverse(m);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat6d inverse")
+{
+  Mat<6, 6, double> m = make_matd<6>();
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Mat<6, 6, double> r = inverse(m);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("mat8d solve")
+{
+  Mat<8, 8, double> m = make_matd<8>();
+  Vec<8, double> b(1.0);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Vec<8, double> x = solve(m, b);
+    bench::do_not_optimize(x);
+  }
+}
@@ -0,0 +1,59 @@
+#include "bench.h"
+
+#include <ndv/mat_cm.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  std::vector<Mat4> make_matrices(std::size_t n)
+  {
+    std::vector<Mat4> result;
+    for (std::size_t i = 0; i < n; i++)
+      result.push_back(translate(Vec3(float(i % 100), 1, -float(i % 37))) * rotate(Vec3(1, float(i % 3), -0.5f), 0.01f * i));
+    return result;
+  }
+}
+
+NDV_BENCHMARK("mat4cm * vec4")
+{
+  Mat4CM m = col_major(perspective(1.0f, 1.5f, 0.1f, 100.0f));
+  Vec4 v(1, 2, 3, 4);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    bench::do_not_optimize(v);
+    Vec4 r = m * v;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK_SIZES("col_major (element loop)", 4096, 262144)
+{
+  std::vector<Mat4> in = make_matrices(state.size);
+  std::vector<Mat4CM> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 2 * sizeof(Mat4);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    for (std::size_t i = 0; i < state.size; i++)
+      for (int r = 0; r < 4; r++)
+        for (int c = 0; c < 4; c++)
+          out[i](r, c) = in[i][r][c];
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("col_major", 4096, 262144)
+{
+  std::vector<Mat4> in = make_matrices(state.size);
+  std::vector<Mat4CM> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 2 * sizeof(Mat4);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    col_major(in, out);
+    bench::do_not_optimize(out.data());
+  }
+}
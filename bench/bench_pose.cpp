@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#include <ndv/pose.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  std::vector<Quat> make_pose(std::size_t count, float phase)
+  {
+    std::vector<Quat> pose(count);
+    for (std::size_t i = 0; i < count; i++)
+      pose[i] = Quat::axis_angle(Vec3(1.0f, 0.5f * i, phase), phase + 0.01f * i);
+    return pose;
+  }
+}
+
+NDV_BENCHMARK_SIZES("pose nlerp per bone", 64, 4096)
+{
+  const std::vector<Quat> a = make_pose(state.size, 0.25f), b = make_pose(state.size, 1.5f);
+  std::vector<Quat> out(state.size);
+  state.items = state.size;
+  state.bytes = 3 * state.size * sizeof(Quat);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    for (std::size_t j = 0; j < state.size; j++)
+      out[j] = nlerp(a[j], b[j], 0.3f);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("pose nlerp blend_poses", 64, 4096)
+{
+  const std::vector<Quat> a = make_pose(state.size, 0.25f), b = make_pose(state.size, 1.5f);
+  std::vector<Quat> out(state.size);
+  state.items = state.size;
+  state.bytes = 3 * state.size * sizeof(Quat);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    blend_poses(a, b, 0.3f, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("pose slerp per bone", 64, 4096)
+{
+  const std::vector<Quat> a = make_pose(state.size, 0.25f), b = make_pose(state.size, 1.5f);
+  std::vector<Quat> out(state.size);
+  state.items = state.size;
+  state.bytes = 3 * state.size * sizeof(Quat);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    for (std::size_t j = 0; j < state.size; j++)
+      out[j] = slerp(a[j], b[j], 0.3f);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("pose slerp blend_poses", 64, 4096)
+{
+  const std::vector<Quat> a = make_pose(state.size, 0.25f), b = make_pose(state.size, 1.5f);
+  std::vector<Quat> out(state.size);
+  state.items = state.size;
+  state.bytes = 3 * state.size * sizeof(Quat);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    blend_poses(a, b, 0.3f, out, PoseBlend::slerp);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("pose blend_layers 3 layers", 64, 4096)
+{
+  const std::vector<Quat> a = make_pose(state.size, 0.25f), b = make_pose(state.size, 1.5f), c = make_pose(state.size, 0.1f);
+  std::vector<Quat> out(state.size);
+  const PoseLayer layers[] = {{a, 0.7f}, {b, 0.3f}, {c, 0.5f, true}};
+  state.items = state.size;
+  state.bytes = 4 * state.size * sizeof(Quat);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    blend_layers(layers, out);
+    bench::do_not_optimize(out.data());
+  }
+}
@@ -0,0 +1,257 @@
+#include "bench.h"
+
+#include <ndv/transform.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  std::vector<Vec3> make_points(std::size_t count)
+  {
+    std::vector<Vec3> points(count);
+    for (std::size_t i = 0; i < count; i++)
+      points[i] = Vec3(1.0f + i, 2.0f - 0.5f * i, 0.25f * i);
+    return points;
+  }
+
+  // the previous rotate, two Hamilton products per vector
+  Vec3 reference_rotate(const Vec3& v, const Quat& by)
+  {
+    const Quat q = by * Quat(v) * conjugate(by);
+    return Vec3(q.x, q.y, q.z);
+  }
+}
+
+NDV_BENCHMARK("quat * quat")
+{
+  Quat a = Quat::axis_angle(Vec3(0, 1, 1), 0.5f), b = Quat::axis_angle(Vec3(1, 0, 0), -1.25f);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    Quat r = a * b;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("quat rotate vec3 (sandwich)")
+{
+  Quat q = Quat::axis_angle(Vec3(0, 1, 1), 0.5f);
+  Vec3 v(1, 2, 3);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(q);
+    bench::do_not_optimize(v);
+    Vec3 r = reference_rotate(v, q);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("quat rotate vec3")
+{
+  Quat q = Quat::axis_angle(Vec3(0, 1, 1), 0.5f);
+  Vec3 v(1, 2, 3);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(q);
+    bench::do_not_optimize(v);
+    Vec3 r = rotate(v, q);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("quat slerp")
+{
+  Quat a = Quat::axis_angle(Vec3(0, 1, 1), 0.5f), b = Quat::axis_angle(Vec3(1, 0, 0), -1.25f);
+  float t = 0.3f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(t);
+    Quat r = slerp(a, b, t);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat rotate points (per vertex)", 64, 4096, 262144)
+{
+  const std::size_t count = state.size;
+  const Quat q = Quat::axis_angle(Vec3(0, 1, 1), 0.5f);
+  std::vector<Vec3> points = make_points(count), out(count);
+  state.items = count;
+  state.bytes = count * 2 * sizeof(Vec3);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    bench::do_not_optimize(q);
+    for (std::size_t i = 0; i < count; i++)
+      out[i] = rotate(points[i], q);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat rotate points", 64, 4096, 262144)
+{
+  const Quat q = Quat::axis_angle(Vec3(0, 1, 1), 0.5f);
+  std::vector<Vec3> points = make_points(state.size), out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 2 * sizeof(Vec3);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    rotate(points, q, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat rotate points (soa)", 64, 4096, 262144)
+{
+  const Quat q = Quat::axis_angle(Vec3(0, 1, 1), 0.5f);
+  Vec3Array points(make_points(state.size)), out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 2 * sizeof(Vec3);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    rotate(points, q, out);
+    bench::do_not_optimize(out.component(0));
+  }
+}
+
+NDV_BENCHMARK("mat4 rotate(axis, angle)")
+{
+  Vec3 axis(0, 1, 1);
+  float angle = 0.5f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(axis);
+    bench::do_not_optimize(angle);
+    Mat4 r = rotate(axis, angle);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("quat to_mat4")
+{
+  Quat q = Quat::axis_angle(Vec3(0, 1, 1), 0.5f);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(q);
+    Mat4 r = to_mat4(q);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("quat from_matrix")
+{
+  Mat3 m = to_mat3(Quat::axis_angle(Vec3(0, 1, 1), 0.5f));
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(m);
+    Quat r = from_matrix(m);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat to_mat4 array", 64, 4096, 65536)
+{
+  std::vector<Quat> quats(state.size);
+  for (std::size_t i = 0; i < state.size; i++)
+    quats[i] = Quat::axis_angle(Vec3(1.0f, float(i % 7), 0.5f), 0.01f * i);
+  std::vector<Mat4> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * (sizeof(Quat) + sizeof(Mat4));
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    to_mat4(quats, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat slerp samples (slerp)", 16, 1024)
+{
+  const Quat a = Quat::axis_angle(Vec3(0, 1, 1), 0.5f), b = Quat::axis_angle(Vec3(1, 0, 0), -1.25f);
+  std::vector<Quat> out(state.size);
+  state.items = state.size;
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    bench::do_not_optimize(a);
+    for (std::size_t k = 0; k < state.size; k++)
+      out[k] = slerp(a, b, float(k) / float(state.size - 1));
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat slerp samples (interpolator)", 16, 1024)
+{
+  const Quat a = Quat::axis_angle(Vec3(0, 1, 1), 0.5f), b = Quat::axis_angle(Vec3(1, 0, 0), -1.25f);
+  std::vector<Quat> out(state.size);
+  state.items = state.size;
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    bench::do_not_optimize(a);
+    const SlerpInterpolator lerp(a, b);
+    for (std::size_t k = 0; k < state.size; k++)
+      out[k] = lerp(float(k) / float(state.size - 1));
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat slerp samples (stepped)", 16, 1024)
+{
+  const Quat a = Quat::axis_angle(Vec3(0, 1, 1), 0.5f), b = Quat::axis_angle(Vec3(1, 0, 0), -1.25f);
+  std::vector<Quat> out(state.size);
+  state.items = state.size;
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    bench::do_not_optimize(a);
+    SlerpInterpolator(a, b).sample(out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+namespace
+{
+  std::vector<Quat> make_track(std::size_t count)
+  {
+    std::vector<Quat> track(count);
+    for (std::size_t i = 0; i < count; i++)
+      track[i] = Quat::axis_angle(Vec3(1.0f, 0.5f * i, 2.0f), 0.01f * i);
+    return track;
+  }
+
+  template<typename Packed>
+  void unpack_track(bench::State& state)
+  {
+    const std::vector<Quat> track = make_track(state.size);
+    std::vector<Packed> packed(state.size);
+    std::vector<Quat> out(state.size);
+    pack(track, packed);
+    state.items = state.size;
+    state.bytes = state.size * (sizeof(Packed) + sizeof(Quat));
+    for (std::size_t i = 0; i < state.iterations; i++)
+    {
+      unpack(packed, out);
+      bench::do_not_optimize(out.data());
+    }
+  }
+}
+
+NDV_BENCHMARK_SIZES("quat unpack 32-bit", 64, 4096, 262144) { unpack_track<PackedQuat32>(state); }
+NDV_BENCHMARK_SIZES("quat unpack 48-bit", 64, 4096, 262144) { unpack_track<PackedQuat48>(state); }
+NDV_BENCHMARK_SIZES("quat unpack 64-bit", 64, 4096, 262144) { unpack_track<PackedQuat64>(state); }
+NDV_BENCHMARK_SIZES("quat unpack snorm16", 64, 4096, 262144) { unpack_track<PackedQuatS16>(state); }
+
+NDV_BENCHMARK_SIZES("quat unpack 32-bit scalar", 64, 4096, 262144)
+{
+  const std::vector<Quat> track = make_track(state.size);
+  std::vector<PackedQuat32> packed(state.size);
+  std::vector<Quat> out(state.size);
+  pack(track, packed);
+  state.items = state.size;
+  state.bytes = state.size * (sizeof(PackedQuat32) + sizeof(Quat));
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    for (std::size_t j = 0; j < state.size; j++)
+      out[j] = packed[j].unpack();
+    bench::do_not_optimize(out.data());
+  }
+}
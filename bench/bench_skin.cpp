@@ -0,0 +1,86 @@
+#include "bench.h"
+
+#include <ndv/skin.h>
+using namespace ndv;
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+  constexpr int influences = 4;
+
+  struct Mesh
+  {
+    std::vector<Mat4> palette;
+    std::vector<Vec3> positions, normals, out_positions, out_normals;
+    std::vector<std::uint16_t> joints;
+    std::vector<float> weights;
+
+    explicit Mesh(std::size_t n) : positions(n), normals(n), out_positions(n), out_normals(n), joints(n * influences), weights(n * influences)
+    {
+      for (int j = 0; j < 64; j++)
+        palette.push_back(translate(Vec3(float(j), 1.0f, 0.5f)) * rotate(Vec3(1.0f, float(j), 2.0f), 0.1f * j));
+      for (std::size_t i = 0; i < n; i++)
+      {
+        positions[i] = Vec3(std::sin(0.1f * i), std::cos(0.3f * i), 0.01f * i);
+        normals[i] = Vec3(0.0f, 1.0f, 0.0f);
+        for (int k = 0; k < influences; k++)
+        {
+          joints[i * influences + k] = std::uint16_t((i / 16 + k) % palette.size());
+          weights[i * influences + k] = 0.25f;
+        }
+      }
+    }
+  };
+
+  void declare_work(bench::State& state)
+  {
+    state.items = state.size;
+    state.bytes = state.size * (4 * sizeof(Vec3) + influences * (sizeof(std::uint16_t) + sizeof(float)));
+  }
+}
+
+// the hand-written loop of Mat4 multiply-adds and Mat4 * Vec4
+NDV_BENCHMARK_SIZES("skin vertices (reference)", 4096, 65536)
+{
+  Mesh mesh(state.size);
+  declare_work(state);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    for (std::size_t i = 0; i < state.size; i++)
+    {
+      Mat4 m = Mat4::zero;
+      for (int k = 0; k < influences; k++)
+        m += mesh.palette[mesh.joints[i * influences + k]] * mesh.weights[i * influences + k];
+      const Vec4 p = m * Vec4(mesh.positions[i].x, mesh.positions[i].y, mesh.positions[i].z, 1);
+      const Vec4 d = m * Vec4(mesh.normals[i].x, mesh.normals[i].y, mesh.normals[i].z, 0);
+      mesh.out_positions[i] = Vec3(p.x, p.y, p.z);
+      mesh.out_normals[i] = Vec3(d.x, d.y, d.z);
+    }
+    bench::do_not_optimize(mesh.out_positions.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("skin vertices", 4096, 65536)
+{
+  Mesh mesh(state.size);
+  declare_work(state);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    skin_vertices(mesh.palette, mesh.positions, mesh.normals, mesh.joints, mesh.weights, influences, mesh.out_positions, mesh.out_normals);
+    bench::do_not_optimize(mesh.out_positions.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("skin vertices (par)", 65536, 1048576)
+{
+  Mesh mesh(state.size);
+  declare_work(state);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    skin_vertices(par, mesh.palette, mesh.positions, mesh.normals, mesh.joints, mesh.weights, influences, mesh.out_positions, mesh.out_normals);
+    bench::do_not_optimize(mesh.out_positions.data());
+  }
+}
@@ -0,0 +1,79 @@
+#include "bench.h"
+
+#include <ndv/storage.h>
+using namespace ndv;
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+  std::vector<Vec3> make_positions(std::size_t count)
+  {
+    std::vector<Vec3> positions(count);
+    for (std::size_t i = 0; i < count; i++)
+      positions[i] = Vec3(std::sin(0.1f * i), std::cos(0.3f * i), 0.5f);
+    return positions;
+  }
+
+  template<typename Packed>
+  void pack_positions(bench::State& state)
+  {
+    const std::vector<Vec3> in = make_positions(state.size);
+    std::vector<Packed> out(state.size);
+    state.items = state.size;
+    state.bytes = state.size * (sizeof(Vec3) + sizeof(Packed));
+    for (std::size_t i = 0; i < state.iterations; i++)
+    {
+      pack(in, out);
+      bench::do_not_optimize(out.data());
+    }
+  }
+
+  template<typename Packed>
+  void unpack_positions(bench::State& state)
+  {
+    const std::vector<Vec3> positions = make_positions(state.size);
+    std::vector<Packed> in(state.size);
+    std::vector<Vec3> out(state.size);
+    pack(positions, in);
+    state.items = state.size;
+    state.bytes = state.size * (sizeof(Vec3) + sizeof(Packed));
+    for (std::size_t i = 0; i < state.iterations; i++)
+    {
+      unpack(in, out);
+      bench::do_not_optimize(out.data());
+    }
+  }
+
+  // a weighted sum reading the stream directly, the arithmetic widens each element
+  template<typename T>
+  void sum_positions(bench::State& state)
+  {
+    const std::vector<Vec3> positions = make_positions(state.size);
+    std::vector<T> in(state.size);
+    if constexpr (std::is_same_v<T, Vec3>)
+      in = positions;
+    else
+      pack(positions, in);
+    state.items = state.size;
+    state.bytes = state.size * sizeof(T);
+    for (std::size_t i = 0; i < state.iterations; i++)
+    {
+      Vec3 acc(0.0f);
+      for (std::size_t j = 0; j < state.size; j++)
+        acc += 0.5f * in[j];
+      bench::do_not_optimize(acc);
+    }
+  }
+}
+
+NDV_BENCHMARK_SIZES("storage pack vec3 half", 4096, 262144) { pack_positions<Vec3h>(state); }
+NDV_BENCHMARK_SIZES("storage unpack vec3 half", 4096, 262144) { unpack_positions<Vec3h>(state); }
+NDV_BENCHMARK_SIZES("storage pack vec3 snorm16", 4096, 262144) { pack_positions<Vec3snorm16>(state); }
+NDV_BENCHMARK_SIZES("storage unpack vec3 snorm16", 4096, 262144) { unpack_positions<Vec3snorm16>(state); }
+NDV_BENCHMARK_SIZES("storage pack vec3 unorm8", 4096, 262144) { pack_positions<Vec3unorm8>(state); }
+NDV_BENCHMARK_SIZES("storage unpack vec3 unorm8", 4096, 262144) { unpack_positions<Vec3unorm8>(state); }
+NDV_BENCHMARK_SIZES("storage sum vec3 float", 4096, 262144) { sum_positions<Vec3>(state); }
+NDV_BENCHMARK_SIZES("storage sum vec3 half", 4096, 262144) { sum_positions<Vec3h>(state); }
+NDV_BENCHMARK_SIZES("storage sum vec3 snorm16", 4096, 262144) { sum_positions<Vec3snorm16>(state); }
@@ -0,0 +1,121 @@
+#include "bench.h"
+
+#include <ndv/transform.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  std::vector<Vec3> make_points(std::size_t count)
+  {
+    std::vector<Vec3> points(count);
+    for (std::size_t i = 0; i < count; i++)
+      points[i] = Vec3(1.0f + i, 2.0f - 0.5f * i, 0.25f * i);
+    return points;
+  }
+
+  Mat4 make_transform()
+  {
+    Mat4 m = translate(Vec3(1, 2, 3));
+    m[0][1] = 0.5f;
+    m[2][0] = -0.25f;
+    return m;
+  }
+
+  // one element read and one written per item
+  template<typename V>
+  void set_work(bench::State& state)
+  {
+    state.items = state.size;
+    state.bytes = state.size * 2 * sizeof(V);
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform points (per vertex)", 64, 4096, 262144)
+{
+  const std::size_t count = state.size;
+  const Mat4 m = make_transform();
+  std::vector<Vec3> points = make_points(count), out(count);
+  set_work<Vec3>(state);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    bench::do_not_optimize(m);
+    for (std::size_t i = 0; i < count; i++)
+    {
+      const Vec4 r = m * Vec4(points[i].x, points[i].y, points[i].z, 1);
+      out[i] = Vec3(r.x / r.w, r.y / r.w, r.z / r.w);
+    }
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform points", 64, 4096, 262144)
+{
+  const Mat4 m = make_transform();
+  std::vector<Vec3> points = make_points(state.size), out(state.size);
+  set_work<Vec3>(state);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    transform_points(m, points, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform directions", 64, 4096, 262144)
+{
+  const Mat4 m = make_transform();
+  std::vector<Vec3> points = make_points(state.size), out(state.size);
+  set_work<Vec3>(state);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    transform_directions(m, points, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform vec4", 64, 4096, 262144)
+{
+  const Mat4 m = make_transform();
+  std::vector<Vec4> v(state.size, Vec4(1, 2, 3, 1)), out(state.size);
+  set_work<Vec4>(state);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    transform_vec4(m, v, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("transform points (par)", 262144, 2097152)
+{
+  const Mat4 m = make_transform();
+  std::vector<Vec3> points = make_points(state.size), out(state.size);
+  set_work<Vec3>(state);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    transform_points(par, m, points, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("normalize points", 4096, 262144)
+{
+  std::vector<Vec3> points = make_points(state.size), out(state.size);
+  set_work<Vec3>(state);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    normalize(points, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("normalize points (par)", 262144, 2097152)
+{
+  std::vector<Vec3> points = make_points(state.size), out(state.size);
+  set_work<Vec3>(state);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    normalize(par, points, out);
+    bench::do_not_optimize(out.data());
+  }
+}
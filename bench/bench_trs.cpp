@@ -0,0 +1,70 @@
+#include "bench.h"
+
+#include <ndv/trs.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  std::vector<TRS> make_transforms(std::size_t n, float seed)
+  {
+    std::vector<TRS> result;
+    for (std::size_t i = 0; i < n; i++)
+      result.emplace_back(Vec3(float(i % 100), seed, -float(i % 37)), Quat::axis_angle(Vec3(1, float(i % 3), seed), 0.01f * i), Vec3(1.0f + 0.01f * (i % 10), 1, 2));
+    return result;
+  }
+}
+
+NDV_BENCHMARK_SIZES("compose (matrix products)", 4096)
+{
+  std::vector<TRS> in = make_transforms(state.size, 0.5f);
+  std::vector<Mat4> out(state.size);
+  state.items = state.size;
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    for (std::size_t i = 0; i < state.size; i++)
+      out[i] = translate(in[i].translation) * to_mat4(in[i].rotation) * scale(in[i].scale);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("compose", 4096)
+{
+  std::vector<TRS> in = make_transforms(state.size, 0.5f);
+  std::vector<Mat4> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * (sizeof(TRS) + sizeof(Mat4));
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    compose(in, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("decompose", 4096)
+{
+  std::vector<Mat4> in(state.size);
+  compose(make_transforms(state.size, 0.5f), in);
+  std::vector<TRS> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * (sizeof(TRS) + sizeof(Mat4));
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    decompose(in, out);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("interpolate_transform", 4096)
+{
+  std::vector<TRS> a = make_transforms(state.size, 0.5f), b = make_transforms(state.size, -0.25f);
+  std::vector<TRS> out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 3 * sizeof(TRS);
+  for (std::size_t iter = 0; iter < state.iterations; iter++)
+  {
+    interpolate_transform(a, b, 0.3f, out);
+    bench::do_not_optimize(out.data());
+  }
+}
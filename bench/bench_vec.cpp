@@ -0,0 +1,146 @@
+#include "bench.h"
+
+#include <ndv/vec.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  template<typename V>
+  std::vector<V> make_vecs(std::size_t count)
+  {
+    std::vector<V> vecs(count);
+    for (std::size_t i = 0; i < count; i++)
+      for (int c = 0; c < int(sizeof(V) / sizeof(vecs[i][0])); c++)
+        vecs[i][c] = 1.0f + 0.5f * c - 0.25f * float(i % 64);
+    return vecs;
+  }
+}
+
+NDV_BENCHMARK("vec3 + vec3")
+{
+  Vec3 a(1, 2, 3), b(-0.5f, 0.25f, 2);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    Vec3 r = a + b;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("vec4 * s + vec4")
+{
+  Vec4 a(1, 2, 3, 4), b(-0.5f, 0.25f, 2, 1);
+  float s = 1.5f;
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(s);
+    Vec4 r = a * s + b;
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("vec3 dot")
+{
+  Vec3 a(1, 2, 3), b(-0.5f, 0.25f, 2);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    float r = dot(a, b);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("vec4 dot")
+{
+  Vec4 a(1, 2, 3, 4), b(-0.5f, 0.25f, 2, 1);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    float r = dot(a, b);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("vec3 cross")
+{
+  Vec3 a(1, 2, 3), b(-0.5f, 0.25f, 2);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(b);
+    Vec3 r = cross(a, b);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("vec3 normalize")
+{
+  Vec3 a(1, 2, 3);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    Vec3 r = normalize(a);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK("vec4 normalize")
+{
+  Vec4 a(1, 2, 3, 4);
+  for (std::size_t i = 0; i < state.iterations; i++)
+  {
+    bench::do_not_optimize(a);
+    Vec4 r = normalize(a);
+    bench::do_not_optimize(r);
+  }
+}
+
+NDV_BENCHMARK_SIZES("vec4 dot array", 64, 4096, 262144)
+{
+  const std::size_t count = state.size;
+  std::vector<Vec4> a = make_vecs<Vec4>(count), b = make_vecs<Vec4>(count);
+  state.items = count;
+  state.bytes = count * 2 * sizeof(Vec4);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    float sum = 0;
+    for (std::size_t i = 0; i < count; i++)
+      sum += dot(a[i], b[i]);
+    bench::do_not_optimize(sum);
+  }
+}
+
+NDV_BENCHMARK_SIZES("vec4 normalize array", 64, 4096, 262144)
+{
+  const std::size_t count = state.size;
+  std::vector<Vec4> a = make_vecs<Vec4>(count), out(count);
+  state.items = count;
+  state.bytes = count * 2 * sizeof(Vec4);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    for (std::size_t i = 0; i < count; i++)
+      out[i] = normalize(a[i]);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("vec3 a + b * s array", 64, 4096, 262144)
+{
+  const std::size_t count = state.size;
+  std::vector<Vec3> a = make_vecs<Vec3>(count), b = make_vecs<Vec3>(count), out(count);
+  const float s = 0.75f;
+  state.items = count;
+  state.bytes = count * 3 * sizeof(Vec3);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    for (std::size_t i = 0; i < count; i++)
+      out[i] = a[i] + b[i] * s;
+    bench::do_not_optimize(out.data());
+  }
+}
@@ -0,0 +1,43 @@
+#include "bench.h"
+
+#include <ndv/vec_array.h>
+using namespace ndv;
+
+#include <vector>
+
+namespace
+{
+  std::vector<Vec3> make_points(std::size_t count)
+  {
+    std::vector<Vec3> points(count);
+    for (std::size_t i = 0; i < count; i++)
+      points[i] = Vec3(1.0f + i, 2.0f - 0.5f * i, 0.25f * i);
+    return points;
+  }
+}
+
+NDV_BENCHMARK_SIZES("normalize vec3 (aos)", 64, 4096, 262144)
+{
+  const std::size_t count = state.size;
+  std::vector<Vec3> points = make_points(count), out(count);
+  state.items = count;
+  state.bytes = count * 2 * sizeof(Vec3);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    for (std::size_t i = 0; i < count; i++)
+      out[i] = normalize(points[i]);
+    bench::do_not_optimize(out.data());
+  }
+}
+
+NDV_BENCHMARK_SIZES("normalize vec3 (soa)", 64, 4096, 262144)
+{
+  Vec3Array points(make_points(state.size)), out(state.size);
+  state.items = state.size;
+  state.bytes = state.size * 2 * sizeof(Vec3);
+  for (std::size_t n = 0; n < state.iterations; n++)
+  {
+    normalize(points, out);
+    bench::do_not_optimize(out.component(0));
+  }
+}
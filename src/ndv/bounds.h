@@ -0,0 +1,514 @@
+#pragma once
+
+#include <ndv/mat.h>
+#include <ndv/simd.h>
+#include <ndv/span.h>
+#include <ndv/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "Bounds Definitions"
+  // Axis-aligned box given by its corners, min <= max on every axis unless the box is empty.
+  template<int N, typename T>
+  struct AABB
+  {
+    Vec<N, T> min;
+    Vec<N, T> max;
+
+    // inverted box, merging anything into it gives that thing
+    static const AABB empty;
+
+    AABB() = default;
+    constexpr AABB(const Vec<N, T>& min, const Vec<N, T>& max) : min(min), max(max) {}
+  };
+  using AABB2 = AABB<2, float>;
+  using AABB3 = AABB<3, float>;
+
+  template<int N, typename T>
+  struct Sphere
+  {
+    Vec<N, T> center;
+    T radius;
+
+    Sphere() = default;
+    constexpr Sphere(const Vec<N, T>& center, T radius) : center(center), radius(radius) {}
+  };
+  using Sphere2 = Sphere<2, float>;
+  using Sphere3 = Sphere<3, float>;
+
+#pragma endregion
+#pragma region "AABB Methods"
+  template<int N, typename T>
+  inline constexpr AABB<N, T> AABB<N, T>::empty = AABB<N, T>(Vec<N, T>(std::numeric_limits<T>::max()), Vec<N, T>(std::numeric_limits<T>::lowest()));
+
+  namespace detail
+  {
+    // component-wise min and max
+    template<int N, typename T>
+    constexpr Vec<N, T> min(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+    {
+      return make_vec<N, T>([&](int i) { return rhs[i] < lhs[i] ? rhs[i] : lhs[i]; });
+    }
+
+    template<int N, typename T>
+    constexpr Vec<N, T> max(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+    {
+      return make_vec<N, T>([&](int i) { return lhs[i] < rhs[i] ? rhs[i] : lhs[i]; });
+    }
+
+    template<typename T>
+    constexpr T abs(T x)
+    {
+      return x < 0 ? -x : x;
+    }
+
+    template<typename T>
+    constexpr Vec<3, T> affine_point(const Mat<4, 4, T>& m, const Vec<3, T>& p)
+    {
+      const Vec<4, T>& r0 = m.row[0];
+      const Vec<4, T>& r1 = m.row[1];
+      const Vec<4, T>& r2 = m.row[2];
+      return Vec<3, T>(
+        r0.x * p.x + r0.y * p.y + r0.z * p.z + r0.w,
+        r1.x * p.x + r1.y * p.y + r1.z * p.z + r1.w,
+        r2.x * p.x + r2.y * p.y + r2.z * p.z + r2.w);
+    }
+  }
+
+  template<int N, typename T>
+  constexpr bool operator==(const AABB<N, T>& lhs, const AABB<N, T>& rhs)
+  {
+    return lhs.min == rhs.min && lhs.max == rhs.max;
+  }
+
+  template<int N, typename T>
+  constexpr bool operator!=(const AABB<N, T>& lhs, const AABB<N, T>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  template<int N, typename T>
+  constexpr bool is_empty(const AABB<N, T>& box)
+  {
+    for (int i = 0; i < N; i++)
+      if (box.max[i] < box.min[i])
+        return true;
+    return false;
+  }
+
+  template<int N, typename T>
+  constexpr Vec<N, T> center(const AABB<N, T>& box)
+  {
+    return (box.min + box.max) * T(0.5);
+  }
+
+  // half the size on every axis
+  template<int N, typename T>
+  constexpr Vec<N, T> extents(const AABB<N, T>& box)
+  {
+    return (box.max - box.min) * T(0.5);
+  }
+
+  template<int N, typename T>
+  constexpr Vec<N, T> size(const AABB<N, T>& box)
+  {
+    return box.max - box.min;
+  }
+
+  // smallest box holding both
+  template<int N, typename T>
+  constexpr AABB<N, T> merge(const AABB<N, T>& lhs, const AABB<N, T>& rhs)
+  {
+    return AABB<N, T>(detail::min(lhs.min, rhs.min), detail::max(lhs.max, rhs.max));
+  }
+
+  template<int N, typename T>
+  constexpr AABB<N, T> merge(const AABB<N, T>& box, const Vec<N, T>& p)
+  {
+    return AABB<N, T>(detail::min(box.min, p), detail::max(box.max, p));
+  }
+
+  // empty (see is_empty) when the boxes do not overlap
+  template<int N, typename T>
+  constexpr AABB<N, T> intersection(const AABB<N, T>& lhs, const AABB<N, T>& rhs)
+  {
+    return AABB<N, T>(detail::max(lhs.min, rhs.min), detail::min(lhs.max, rhs.max));
+  }
+
+  // touching boxes intersect
+  template<int N, typename T>
+  constexpr bool intersects(const AABB<N, T>& lhs, const AABB<N, T>& rhs)
+  {
+    for (int i = 0; i < N; i++)
+      if (lhs.max[i] < rhs.min[i] || rhs.max[i] < lhs.min[i])
+        return false;
+    return true;
+  }
+
+  template<int N, typename T>
+  constexpr bool contains(const AABB<N, T>& box, const Vec<N, type_identity_t<T>>& p)
+  {
+    for (int i = 0; i < N; i++)
+      if (p[i] < box.min[i] || box.max[i] < p[i])
+        return false;
+    return true;
+  }
+
+  template<int N, typename T>
+  constexpr bool contains(const AABB<N, T>& box, const AABB<N, T>& inner)
+  {
+    for (int i = 0; i < N; i++)
+      if (inner.min[i] < box.min[i] || box.max[i] < inner.max[i])
+        return false;
+    return true;
+  }
+
+  // empty for no points
+  template<int N, typename T>
+  constexpr AABB<N, T> bounding_box(span<const Vec<N, T>> points)
+  {
+    AABB<N, T> result = AABB<N, T>::empty;
+    for (const Vec<N, T>& p : points)
+      result = merge(result, p);
+    return result;
+  }
+
+  template<int N, typename T>
+  constexpr AABB<N, T> bounding_box(const Sphere<N, T>& sphere)
+  {
+    return AABB<N, T>(sphere.center - Vec<N, T>(sphere.radius), sphere.center + Vec<N, T>(sphere.radius));
+  }
+
+  // Arvo's method: the center goes through the matrix and the extents through the absolute
+  // values of its upper 3x3 block, which is the exact bound of the 8 transformed corners at the
+  // cost of transforming two points.
+  // NOTE: the matrix must be affine and the box not empty
+  template<typename T>
+  constexpr AABB<3, T> transform(const Mat<4, 4, T>& m, const AABB<3, type_identity_t<T>>& box)
+  {
+    const Vec<3, T> c((box.min.x + box.max.x) * T(0.5), (box.min.y + box.max.y) * T(0.5), (box.min.z + box.max.z) * T(0.5));
+    const Vec<3, T> e((box.max.x - box.min.x) * T(0.5), (box.max.y - box.min.y) * T(0.5), (box.max.z - box.min.z) * T(0.5));
+    const Vec<3, T> rc = detail::affine_point(m, c);
+    const Vec<4, T>& r0 = m.row[0];
+    const Vec<4, T>& r1 = m.row[1];
+    const Vec<4, T>& r2 = m.row[2];
+    const Vec<3, T> re(
+      detail::abs(r0.x) * e.x + detail::abs(r0.y) * e.y + detail::abs(r0.z) * e.z,
+      detail::abs(r1.x) * e.x + detail::abs(r1.y) * e.y + detail::abs(r1.z) * e.z,
+      detail::abs(r2.x) * e.x + detail::abs(r2.y) * e.y + detail::abs(r2.z) * e.z);
+    return AABB<3, T>(
+      Vec<3, T>(rc.x - re.x, rc.y - re.y, rc.z - re.z),
+      Vec<3, T>(rc.x + re.x, rc.y + re.y, rc.z + re.z));
+  }
+
+#pragma endregion
+#pragma region "Sphere Methods"
+  template<int N, typename T>
+  constexpr bool operator==(const Sphere<N, T>& lhs, const Sphere<N, T>& rhs)
+  {
+    return lhs.center == rhs.center && lhs.radius == rhs.radius;
+  }
+
+  template<int N, typename T>
+  constexpr bool operator!=(const Sphere<N, T>& lhs, const Sphere<N, T>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  // smallest sphere holding both
+  template<int N, typename T>
+  inline Sphere<N, T> merge(const Sphere<N, T>& lhs, const Sphere<N, T>& rhs)
+  {
+    const Vec<N, T> offset = rhs.center - lhs.center;
+    const T d = length(offset);
+    if (d + rhs.radius <= lhs.radius)
+      return lhs;
+    if (d + lhs.radius <= rhs.radius)
+      return rhs;
+    const T radius = (d + lhs.radius + rhs.radius) * T(0.5);
+    return Sphere<N, T>(lhs.center + offset * ((radius - lhs.radius) / d), radius);
+  }
+
+  // spheres are not closed under intersection, so there is no intersection() for them
+  template<int N, typename T>
+  constexpr bool intersects(const Sphere<N, T>& lhs, const Sphere<N, T>& rhs)
+  {
+    const T r = lhs.radius + rhs.radius;
+    return distance_squared(lhs.center, rhs.center) <= r * r;
+  }
+
+  // distance from the sphere center to the closest point of the box
+  template<int N, typename T>
+  constexpr bool intersects(const AABB<N, T>& box, const Sphere<N, T>& sphere)
+  {
+    const Vec<N, T> closest = detail::min(detail::max(sphere.center, box.min), box.max);
+    return distance_squared(closest, sphere.center) <= sphere.radius * sphere.radius;
+  }
+
+  template<int N, typename T>
+  constexpr bool intersects(const Sphere<N, T>& sphere, const AABB<N, T>& box)
+  {
+    return intersects(box, sphere);
+  }
+
+  template<int N, typename T>
+  constexpr bool contains(const Sphere<N, T>& sphere, const Vec<N, type_identity_t<T>>& p)
+  {
+    return distance_squared(sphere.center, p) <= sphere.radius * sphere.radius;
+  }
+
+  template<int N, typename T>
+  inline bool contains(const Sphere<N, T>& sphere, const Sphere<N, T>& inner)
+  {
+    return inner.radius <= sphere.radius && distance(sphere.center, inner.center) + inner.radius <= sphere.radius;
+  }
+
+  // sphere through the corners, not the smallest one around the box contents
+  template<int N, typename T>
+  inline Sphere<N, T> bounding_sphere(const AABB<N, T>& box)
+  {
+    return Sphere<N, T>(center(box), length(extents(box)));
+  }
+
+  // largest length of the images of the unit axes, by which transform() scales a radius
+  template<typename T>
+  inline T max_scale(const Mat<4, 4, T>& m)
+  {
+    T result = 0;
+    for (int j = 0; j < 3; j++)
+      result = std::max(result, m.row[0][j] * m.row[0][j] + m.row[1][j] * m.row[1][j] + m.row[2][j] * m.row[2][j]);
+    return std::sqrt(result);
+  }
+
+  // the radius scales by max_scale(), which bounds the sphere tightly for rotation, translation
+  // and (non-uniform) scale, and is conservative enough for mild shear.
+  // NOTE: the matrix must be affine
+  template<typename T>
+  inline Sphere<3, T> transform(const Mat<4, 4, T>& m, const Sphere<3, type_identity_t<T>>& sphere)
+  {
+    return Sphere<3, T>(detail::affine_point(m, sphere.center), sphere.radius * max_scale(m));
+  }
+
+#pragma endregion
+#pragma region "Batch Bounds Methods"
+  // Batched transform() of object bounds, all by one matrix here or (for float) each by its own,
+  // e.g. local bounds by world matrices, below. Every element is read before its output is
+  // written, so out may be the same span as in.
+  template<typename T>
+  inline void transform_bounds(const Mat<4, 4, T>& m, span<const AABB<3, type_identity_t<T>>> in, span<AABB<3, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    for (std::size_t i = 0; i < in.size(); i++)
+      out[i] = transform(m, in[i]);
+  }
+
+  template<typename T>
+  inline void transform_bounds(const Mat<4, 4, T>& m, span<const Sphere<3, type_identity_t<T>>> in, span<Sphere<3, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    const T scale = max_scale(m);
+    for (std::size_t i = 0; i < in.size(); i++)
+      out[i] = Sphere<3, T>(detail::affine_point(m, in[i].center), in[i].radius * scale);
+  }
+
+#pragma endregion
+#if defined(NDV_SIMD_SSE)
+#pragma region "Batch Bounds SIMD Methods"
+  namespace detail
+  {
+    // rows 0..2 of a matrix as 12 lanes, element (i, j) at 4 * i + j, with the absolute values
+    // of the 3x3 block at 3 * i + j
+    struct BoundsLanes
+    {
+      __m128 m[12];
+      __m128 a[9];
+
+      void set_abs()
+      {
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        for (int i = 0; i < 3; i++)
+          for (int j = 0; j < 3; j++)
+            a[3 * i + j] = _mm_andnot_ps(sign, m[4 * i + j]);
+      }
+
+      // the same matrix in every lane
+      void broadcast(const Mat<4, 4, float>& rhs)
+      {
+        for (int i = 0; i < 3; i++)
+          for (int j = 0; j < 4; j++)
+            m[4 * i + j] = _mm_set1_ps(rhs.row[i][j]);
+        set_abs();
+      }
+
+      // the matrices of four objects, one per lane
+      void transpose(const Mat<4, 4, float>* rhs)
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          __m128 r0 = _mm_loadu_ps(rhs[0].row[i].data);
+          __m128 r1 = _mm_loadu_ps(rhs[1].row[i].data);
+          __m128 r2 = _mm_loadu_ps(rhs[2].row[i].data);
+          __m128 r3 = _mm_loadu_ps(rhs[3].row[i].data);
+          _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+          m[4 * i] = r0;
+          m[4 * i + 1] = r1;
+          m[4 * i + 2] = r2;
+          m[4 * i + 3] = r3;
+        }
+        set_abs();
+      }
+
+      void point(__m128& x, __m128& y, __m128& z) const
+      {
+        const __m128 rx = simd::madd(m[0], x, simd::madd(m[1], y, simd::madd(m[2], z, m[3])));
+        const __m128 ry = simd::madd(m[4], x, simd::madd(m[5], y, simd::madd(m[6], z, m[7])));
+        const __m128 rz = simd::madd(m[8], x, simd::madd(m[9], y, simd::madd(m[10], z, m[11])));
+        x = rx;
+        y = ry;
+        z = rz;
+      }
+
+      // squared max_scale() per lane
+      __m128 max_scale_squared() const
+      {
+        __m128 result = _mm_setzero_ps();
+        for (int j = 0; j < 3; j++)
+        {
+          const __m128 col = simd::madd(m[j], m[j], simd::madd(m[4 + j], m[4 + j], _mm_mul_ps(m[8 + j], m[8 + j])));
+          result = _mm_max_ps(result, col);
+        }
+        return result;
+      }
+    };
+
+    // four boxes (24 packed floats), read as 8 xyz triples: the lanes come out as min0, max0,
+    // min1, max1 and min2, max2, min3, max3, and are shuffled into min and max lanes
+    inline void transform_aabb4(const BoundsLanes& lanes, const float* src, float* dst)
+    {
+      __m128 x0, y0, z0, x1, y1, z1;
+      simd::load_xyz4(src, x0, y0, z0);
+      simd::load_xyz4(src + 12, x1, y1, z1);
+
+      const __m128 half = _mm_set1_ps(0.5f);
+      const __m128 lo[3] = {
+        _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0)),
+        _mm_shuffle_ps(y0, y1, _MM_SHUFFLE(2, 0, 2, 0)),
+        _mm_shuffle_ps(z0, z1, _MM_SHUFFLE(2, 0, 2, 0))};
+      const __m128 hi[3] = {
+        _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)),
+        _mm_shuffle_ps(y0, y1, _MM_SHUFFLE(3, 1, 3, 1)),
+        _mm_shuffle_ps(z0, z1, _MM_SHUFFLE(3, 1, 3, 1))};
+      __m128 c[3], e[3];
+      for (int k = 0; k < 3; k++)
+      {
+        c[k] = _mm_mul_ps(_mm_add_ps(hi[k], lo[k]), half);
+        e[k] = _mm_mul_ps(_mm_sub_ps(hi[k], lo[k]), half);
+      }
+
+      lanes.point(c[0], c[1], c[2]);
+      __m128 rmin[3], rmax[3];
+      for (int i = 0; i < 3; i++)
+      {
+        const __m128 re = simd::madd(lanes.a[3 * i], e[0], simd::madd(lanes.a[3 * i + 1], e[1], _mm_mul_ps(lanes.a[3 * i + 2], e[2])));
+        rmin[i] = _mm_sub_ps(c[i], re);
+        rmax[i] = _mm_add_ps(c[i], re);
+      }
+
+      simd::store_xyz4(dst, _mm_unpacklo_ps(rmin[0], rmax[0]), _mm_unpacklo_ps(rmin[1], rmax[1]), _mm_unpacklo_ps(rmin[2], rmax[2]));
+      simd::store_xyz4(dst + 12, _mm_unpackhi_ps(rmin[0], rmax[0]), _mm_unpackhi_ps(rmin[1], rmax[1]), _mm_unpackhi_ps(rmin[2], rmax[2]));
+    }
+
+    // four spheres (16 packed floats), scale multiplies the radii
+    inline void transform_sphere4(const BoundsLanes& lanes, __m128 scale, const float* src, float* dst)
+    {
+      __m128 x, y, z, r;
+      simd::load_transpose4(src, x, y, z, r);
+      lanes.point(x, y, z);
+      simd::store_transpose4(dst, x, y, z, _mm_mul_ps(r, scale));
+    }
+  }
+
+  // four objects per step with the matrix broadcast in lanes, the last n % 4 use transform()
+  template<>
+  inline void transform_bounds(const Mat<4, 4, float>& m, span<const AABB<3, float>> in, span<AABB<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    const std::size_t n4 = n & ~std::size_t(3);
+    detail::BoundsLanes lanes;
+    lanes.broadcast(m);
+    for (std::size_t i = 0; i < n4; i += 4)
+      detail::transform_aabb4(lanes, in[i].min.data, out[i].min.data);
+    for (std::size_t i = n4; i < n; i++)
+      out[i] = transform(m, in[i]);
+  }
+
+  template<>
+  inline void transform_bounds(const Mat<4, 4, float>& m, span<const Sphere<3, float>> in, span<Sphere<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    const std::size_t n4 = n & ~std::size_t(3);
+    detail::BoundsLanes lanes;
+    lanes.broadcast(m);
+    const __m128 scale = _mm_set1_ps(max_scale(m));
+    for (std::size_t i = 0; i < n4; i += 4)
+      detail::transform_sphere4(lanes, scale, in[i].center.data, out[i].center.data);
+    for (std::size_t i = n4; i < n; i++)
+      out[i] = transform(m, in[i]);
+  }
+
+#pragma endregion
+#endif
+#pragma region "Batch Bounds Per-Object Methods"
+  // each object by its own matrix. with SIMD, four objects per step with the matrices transposed
+  // into lanes, one per object
+  inline void transform_bounds(span<const Mat<4, 4, float>> m, span<const AABB<3, float>> in, span<AABB<3, float>> out)
+  {
+    assert(m.size() == in.size() && in.size() == out.size());
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    detail::BoundsLanes lanes;
+    for (; i + 4 <= n; i += 4)
+    {
+      lanes.transpose(&m[i]);
+      detail::transform_aabb4(lanes, in[i].min.data, out[i].min.data);
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = transform(m[i], in[i]);
+  }
+
+  inline void transform_bounds(span<const Mat<4, 4, float>> m, span<const Sphere<3, float>> in, span<Sphere<3, float>> out)
+  {
+    assert(m.size() == in.size() && in.size() == out.size());
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    detail::BoundsLanes lanes;
+    for (; i + 4 <= n; i += 4)
+    {
+      lanes.transpose(&m[i]);
+      detail::transform_sphere4(lanes, _mm_sqrt_ps(lanes.max_scale_squared()), in[i].center.data, out[i].center.data);
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = transform(m[i], in[i]);
+  }
+
+#pragma endregion
+#pragma region "Layout Checks"
+  // the SIMD paths read boxes as 6 and spheres as 4 packed floats
+  static_assert(sizeof(AABB<3, float>) == 6 * sizeof(float) && std::is_trivially_copyable_v<AABB<3, float>>);
+  static_assert(sizeof(Sphere<3, float>) == 4 * sizeof(float) && std::is_trivially_copyable_v<Sphere<3, float>>);
+
+#pragma endregion
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <ndv/mat.h>
+#include <ndv/quat.h>
+#include <ndv/span.h>
+#include <ndv/vec.h>
+
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "DualQuat Definitions"
+  // Rigid transform (rotation then translation) as a unit dual quaternion real + e dual, with
+  // dual = 0.5 * Quat(translation) * real. Products compose like matrices: (a * b) applies b first.
+  struct DualQuat
+  {
+    Quat real;
+    Quat dual;
+
+    static const DualQuat identity;
+
+    constexpr DualQuat() : real(), dual(0, 0, 0, 0) {}
+    constexpr DualQuat(const Quat& real, const Quat& dual) : real(real), dual(dual) {}
+    constexpr DualQuat(const Quat& rotation, const Vec<3, float>& translation);
+    explicit DualQuat(const Mat<4, 4, float>& m);
+
+    constexpr DualQuat& operator+=(const DualQuat& rhs);
+    constexpr DualQuat& operator-=(const DualQuat& rhs);
+    constexpr DualQuat& operator*=(const DualQuat& rhs);
+    constexpr DualQuat& operator*=(float rhs);
+  };
+
+#pragma endregion
+#pragma region "Base Methods"
+  inline constexpr DualQuat DualQuat::identity = DualQuat();
+
+  // NOTE: rotation must be normalized
+  constexpr DualQuat::DualQuat(const Quat& rotation, const Vec<3, float>& translation)
+    : real(rotation), dual(Quat(translation) * rotation * 0.5f)
+  {
+  }
+
+  // rotation from the upper 3x3 block (see from_matrix), translation from the last column
+  inline DualQuat::DualQuat(const Mat<4, 4, float>& m)
+    : DualQuat(from_matrix(m), Vec<3, float>(m.row[0].w, m.row[1].w, m.row[2].w))
+  {
+  }
+
+  constexpr DualQuat& DualQuat::operator+=(const DualQuat& rhs)
+  {
+    real += rhs.real;
+    dual += rhs.dual;
+    return *this;
+  }
+
+  constexpr DualQuat& DualQuat::operator-=(const DualQuat& rhs)
+  {
+    real -= rhs.real;
+    dual -= rhs.dual;
+    return *this;
+  }
+
+  constexpr DualQuat& DualQuat::operator*=(const DualQuat& rhs)
+  {
+    dual = real * rhs.dual + dual * rhs.real;
+    real *= rhs.real;
+    return *this;
+  }
+
+  constexpr DualQuat& DualQuat::operator*=(float rhs)
+  {
+    real *= rhs;
+    dual *= rhs;
+    return *this;
+  }
+
+  constexpr DualQuat operator-(const DualQuat& rhs)
+  {
+    return DualQuat(-rhs.real, -rhs.dual);
+  }
+
+  constexpr DualQuat operator+(const DualQuat& lhs, const DualQuat& rhs)
+  {
+    return DualQuat(lhs.real + rhs.real, lhs.dual + rhs.dual);
+  }
+
+  constexpr DualQuat operator-(const DualQuat& lhs, const DualQuat& rhs)
+  {
+    return DualQuat(lhs.real - rhs.real, lhs.dual - rhs.dual);
+  }
+
+  constexpr DualQuat operator*(const DualQuat& lhs, const DualQuat& rhs)
+  {
+    return DualQuat(lhs.real * rhs.real, lhs.real * rhs.dual + lhs.dual * rhs.real);
+  }
+
+  constexpr DualQuat operator*(const DualQuat& lhs, float rhs)
+  {
+    return DualQuat(lhs.real * rhs, lhs.dual * rhs);
+  }
+
+  constexpr DualQuat operator*(float lhs, const DualQuat& rhs)
+  {
+    return DualQuat(lhs * rhs.real, lhs * rhs.dual);
+  }
+
+  constexpr bool operator==(const DualQuat& lhs, const DualQuat& rhs)
+  {
+    return lhs.real == rhs.real && lhs.dual == rhs.dual;
+  }
+
+  constexpr bool operator!=(const DualQuat& lhs, const DualQuat& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+#pragma endregion
+#pragma region "Utility Methods"
+  // Scales both parts by 1 / |real| and removes the component of dual along real, so the result
+  // is a unit dual quaternion again (e.g. after blending). real must not be zero.
+  inline DualQuat normalize(const DualQuat& rhs)
+  {
+    const float inv = 1.0f / length(rhs.real);
+    const Quat real = rhs.real * inv;
+    const Quat dual = rhs.dual * inv;
+    return DualQuat(real, dual - real * dot(real, dual));
+  }
+
+  constexpr DualQuat conjugate(const DualQuat& rhs)
+  {
+    return DualQuat(conjugate(rhs.real), conjugate(rhs.dual));
+  }
+
+  // NOTE: dual quaternion must be normalized, the inverse is then the quaternion conjugate
+  constexpr DualQuat inverse(const DualQuat& rhs)
+  {
+    return conjugate(rhs);
+  }
+
+  constexpr Quat rotation(const DualQuat& rhs)
+  {
+    return rhs.real;
+  }
+
+  // NOTE: dual quaternion must be normalized
+  // vector part of 2 * dual * conjugate(real)
+  constexpr Vec<3, float> translation(const DualQuat& rhs)
+  {
+    const Quat& r = rhs.real;
+    const Quat& d = rhs.dual;
+    return Vec<3, float>(
+      2 * (r.w * d.x - d.w * r.x + r.y * d.z - r.z * d.y),
+      2 * (r.w * d.y - d.w * r.y + r.z * d.x - r.x * d.z),
+      2 * (r.w * d.z - d.w * r.z + r.x * d.y - r.y * d.x));
+  }
+
+  // NOTE: dual quaternion must be normalized
+  constexpr Vec<3, float> transform_point(const DualQuat& by, const Vec<3, float>& p)
+  {
+    return rotate(p, by.real) + translation(by);
+  }
+
+  // NOTE: dual quaternion must be normalized
+  constexpr Vec<3, float> transform_direction(const DualQuat& by, const Vec<3, float>& v)
+  {
+    return rotate(v, by.real);
+  }
+
+  // NOTE: dual quaternion must be normalized
+  constexpr Mat<4, 4, float> to_mat4(const DualQuat& rhs)
+  {
+    Mat<4, 4, float> result = to_mat4(rhs.real);
+    const Vec<3, float> t = translation(rhs);
+    result.row[0].w = t.x;
+    result.row[1].w = t.y;
+    result.row[2].w = t.z;
+    return result;
+  }
+
+  // Dual quaternion linear blending (Kavan et al.): the weighted sum of the transforms, each
+  // flipped into the hemisphere of the first so the blend takes the shorter path, normalized.
+  // Unlike blending matrices it stays rigid, so skinned joints do not collapse.
+  inline DualQuat blend(const DualQuat& a, const DualQuat& b, float t)
+  {
+    const float wb = dot(a.real, b.real) < 0 ? -t : t;
+    return normalize(a * (1 - t) + b * wb);
+  }
+
+  // weights need not sum to one, but must not cancel out
+  inline DualQuat blend(span<const DualQuat> dqs, span<const float> weights)
+  {
+    assert(dqs.size() == weights.size() && !dqs.empty());
+    DualQuat sum(Quat(0.0f), Quat(0.0f));
+    for (std::size_t i = 0; i < dqs.size(); i++)
+    {
+      const float w = dot(dqs[0].real, dqs[i].real) < 0 ? -weights[i] : weights[i];
+      sum += dqs[i] * w;
+    }
+    return normalize(sum);
+  }
+
+#pragma endregion
+#pragma region "Layout Checks"
+  // stored as real.w, real.x, real.y, real.z, dual.w, dual.x, dual.y, dual.z
+  static_assert(std::is_trivially_copyable_v<DualQuat> && std::is_standard_layout_v<DualQuat>);
+  static_assert(sizeof(DualQuat) == 8 * sizeof(float));
+
+#pragma endregion
+}
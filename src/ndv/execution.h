@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Execution policies for the batch kernels. A kernel taking a policy as its first argument splits
+// its spans into cache-sized blocks and runs them
+//
+//   seq                  on the calling thread, like the overload without a policy
+//   par                  on the shared ThreadPool::instance()
+//   par.on(executor)     on any executor with a bulk(count, fn) member that calls fn(i) for every
+//                        i < count and returns once all calls are done, e.g. a ThreadPool of its own
+//
+// Blocks are disjoint, so kernels that allow out to alias in still do under every policy.
+namespace ndv
+{
+#pragma region "Thread Pool Definitions"
+  // Work-stealing pool. bulk(count, fn) deals the indices to the worker queues in contiguous runs,
+  // each worker takes its own from the front and, once out of work, steals from the back of the
+  // others. The calling thread steals as well until every call is done, so bulk may also be
+  // called from inside a running task. The first exception thrown by fn is rethrown by bulk.
+  class ThreadPool
+  {
+  public:
+    // threads workers besides the calling thread, with none everything runs on the caller
+    explicit ThreadPool(std::size_t threads = default_threads());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return worker_count; }
+
+    template<typename F>
+    void bulk(std::size_t count, F&& fn);
+
+    // pool used by par, one worker less than the hardware threads
+    static ThreadPool& instance();
+    static std::size_t default_threads();
+
+  private:
+    struct Job
+    {
+      void (*invoke)(void* fn, std::size_t i);
+      void* fn;
+      std::atomic<std::size_t> pending;
+      std::atomic<bool> failed{false};
+      std::exception_ptr error;
+    };
+
+    struct Task
+    {
+      Job* job;
+      std::size_t index;
+    };
+
+    // own line per queue, the owners and thieves of different queues do not share one
+    struct alignas(64) Queue
+    {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    void submit(Job& job, std::size_t count);
+    bool run_one(std::size_t first, bool own);
+    void run(const Task& task);
+    void work(std::size_t self);
+
+    // set before the workers start, which read it while later ones are still being created
+    const std::size_t worker_count;
+    std::unique_ptr<Queue[]> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> queued{0};
+    bool stopping = false;
+  };
+
+#pragma endregion
+#pragma region "Execution Policy Definitions"
+  template<typename E>
+  struct ExecutorPolicy
+  {
+    E* executor;
+  };
+
+  struct SequencedPolicy {};
+
+  struct ParallelPolicy
+  {
+    template<typename E>
+    constexpr ExecutorPolicy<E> on(E& executor) const { return ExecutorPolicy<E>{&executor}; }
+  };
+
+  inline constexpr SequencedPolicy seq{};
+  inline constexpr ParallelPolicy par{};
+
+  template<typename P> struct is_execution_policy : std::false_type {};
+  template<> struct is_execution_policy<SequencedPolicy> : std::true_type {};
+  template<> struct is_execution_policy<ParallelPolicy> : std::true_type {};
+  template<typename E> struct is_execution_policy<ExecutorPolicy<E>> : std::true_type {};
+  template<typename P> constexpr bool is_execution_policy_v = is_execution_policy<std::decay_t<P>>::value;
+
+#pragma endregion
+#pragma region "Thread Pool Methods"
+  namespace detail
+  {
+    // the pool and queue of the calling thread when it is a worker
+    struct PoolWorker
+    {
+      const void* pool = nullptr;
+      std::size_t index = 0;
+    };
+
+    inline PoolWorker& current_worker()
+    {
+      static thread_local PoolWorker worker;
+      return worker;
+    }
+  }
+
+  inline ThreadPool::ThreadPool(std::size_t threads) : worker_count(threads), queues(new Queue[std::max<std::size_t>(threads, 1)])
+  {
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++)
+      workers.emplace_back(&ThreadPool::work, this, i);
+  }
+
+  inline ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+      worker.join();
+  }
+
+  inline ThreadPool& ThreadPool::instance()
+  {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  inline std::size_t ThreadPool::default_threads()
+  {
+    const std::size_t hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+  }
+
+  template<typename F>
+  inline void ThreadPool::bulk(std::size_t count, F&& fn)
+  {
+    if (worker_count == 0 || count <= 1)
+    {
+      for (std::size_t i = 0; i < count; i++)
+        fn(i);
+      return;
+    }
+
+    using Fn = std::remove_reference_t<F>;
+    Job job;
+    job.invoke = [](void* f, std::size_t i) { (*static_cast<Fn*>(f))(i); };
+    job.fn = const_cast<void*>(static_cast<const void*>(std::addressof(fn)));
+    job.pending.store(count, std::memory_order_relaxed);
+    submit(job, count);
+
+    // a worker starts with its own queue, any other thread only steals
+    const detail::PoolWorker& self = detail::current_worker();
+    const bool own = self.pool == this;
+    const std::size_t first = own ? self.index : 0;
+    while (job.pending.load(std::memory_order_acquire) != 0)
+    {
+      if (!run_one(first, own))
+        std::this_thread::yield();
+    }
+    if (job.error)
+      std::rethrow_exception(job.error);
+  }
+
+  // counted before they are queued, so a worker woken for them keeps looking until it finds them
+  inline void ThreadPool::submit(Job& job, std::size_t count)
+  {
+    const std::size_t n = worker_count;
+    queued.fetch_add(count, std::memory_order_relaxed);
+    for (std::size_t q = 0; q < n; q++)
+    {
+      std::lock_guard<std::mutex> lock(queues[q].mutex);
+      for (std::size_t i = count * q / n; i < count * (q + 1) / n; i++)
+        queues[q].tasks.push_back(Task{&job, i});
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    wake.notify_all();
+  }
+
+  // runs one task from queue first (front if it is the caller's own) or any other (back)
+  inline bool ThreadPool::run_one(std::size_t first, bool own)
+  {
+    const std::size_t n = worker_count;
+    for (std::size_t k = 0; k < n; k++)
+    {
+      Queue& queue = queues[(first + k) % n];
+      std::unique_lock<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty())
+        continue;
+
+      Task task;
+      if (own && k == 0)
+      {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+      }
+      else
+      {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+      }
+      lock.unlock();
+      queued.fetch_sub(1, std::memory_order_relaxed);
+      run(task);
+      return true;
+    }
+    return false;
+  }
+
+  // pending is the last access to the job, which lives on the stack of the bulk call
+  inline void ThreadPool::run(const Task& task)
+  {
+    Job& job = *task.job;
+    try
+    {
+      job.invoke(job.fn, task.index);
+    }
+    catch (...)
+    {
+      if (!job.failed.exchange(true))
+        job.error = std::current_exception();
+    }
+    job.pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  inline void ThreadPool::work(std::size_t self)
+  {
+    detail::current_worker() = detail::PoolWorker{this, self};
+    for (;;)
+    {
+      if (run_one(self, true))
+        continue;
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) != 0; });
+      if (stopping && queued.load(std::memory_order_relaxed) == 0)
+        return;
+    }
+  }
+
+#pragma endregion
+#pragma region "Execution Policy Methods"
+  namespace detail
+  {
+    // elements per block for kernels streaming bytes_per_item through memory: about 64 KiB of
+    // data, which stays in L2 and amortizes the queue, in whole multiples of 64 elements so
+    // blocks keep SIMD and cache line alignment
+    constexpr std::size_t block_size(std::size_t bytes_per_item)
+    {
+      const std::size_t items = (std::size_t(64) * 1024 / bytes_per_item) & ~std::size_t(63);
+      return items > 64 ? items : 64;
+    }
+
+    // fn(begin, end) over [0, n) in blocks of block elements, the last one shorter
+    template<typename F>
+    inline void for_each_block(SequencedPolicy, std::size_t n, std::size_t, F&& fn)
+    {
+      if (n)
+        fn(std::size_t(0), n);
+    }
+
+    template<typename E, typename F>
+    inline void for_each_block(ExecutorPolicy<E> policy, std::size_t n, std::size_t block, F&& fn)
+    {
+      const std::size_t blocks = (n + block - 1) / block;
+      if (blocks <= 1)
+        return for_each_block(seq, n, block, fn);
+      policy.executor->bulk(blocks, [&](std::size_t i) { fn(i * block, std::min(n, (i + 1) * block)); });
+    }
+
+    template<typename F>
+    inline void for_each_block(ParallelPolicy, std::size_t n, std::size_t block, F&& fn)
+    {
+      for_each_block(par.on(ThreadPool::instance()), n, block, fn);
+    }
+  }
+
+#pragma endregion
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <ndv/mat.h>
+#include <ndv/vec.h>
+
+#include <type_traits>
+
+// Opt-in expression templates for element-wise Vec and Mat arithmetic. Wrapping an operand in
+// lazy() makes +, -, negation, scalar * and / (and element-wise Vec * and /) build an expression
+// tree instead of a full temporary per operator. The tree is evaluated in a single pass when it is
+// converted to its result type or handed to eval/assign:
+//
+//   Vec<64, float> r = lazy(a) + lazy(b) * s - c;
+//
+// Nodes keep references to their Vec and Mat operands, so an expression must be evaluated within
+// the full-expression that builds it, never kept in an auto variable. Vec2/3/4 and Mats of up to
+// 4x4 are already register sized, so lazy() hands them back unchanged and the eager (and SIMD)
+// operators are used for them.
+namespace ndv
+{
+#pragma region "Expression Definitions"
+  namespace detail
+  {
+    struct expr_tag {};
+
+    // element grid of a result type, Vecs are a single row
+    template<typename R> struct expr_shape;
+    template<int N, typename T>
+    struct expr_shape<Vec<N, T>>
+    {
+      static constexpr int rows = 1;
+      static constexpr int cols = N;
+      using value_type = T;
+    };
+    template<int N, int M, typename T>
+    struct expr_shape<Mat<N, M, T>>
+    {
+      static constexpr int rows = N;
+      static constexpr int cols = M;
+      using value_type = T;
+    };
+
+    struct expr_add { template<typename T> constexpr T operator()(T lhs, T rhs) const { return lhs + rhs; } };
+    struct expr_sub { template<typename T> constexpr T operator()(T lhs, T rhs) const { return lhs - rhs; } };
+    struct expr_mul { template<typename T> constexpr T operator()(T lhs, T rhs) const { return lhs * rhs; } };
+    struct expr_div { template<typename T> constexpr T operator()(T lhs, T rhs) const { return lhs / rhs; } };
+    struct expr_neg { template<typename T> constexpr T operator()(T rhs) const { return -rhs; } };
+  }
+
+  // base of every expression node, E is the node and R the Vec or Mat it evaluates to
+  template<typename E, typename R>
+  struct Expr : detail::expr_tag
+  {
+    using result_type = R;
+    using value_type = typename detail::expr_shape<R>::value_type;
+
+    constexpr const E& self() const;
+    constexpr operator R() const;
+  };
+
+  // Vec or Mat operand, held by reference
+  template<typename R>
+  struct ExprLeaf : Expr<ExprLeaf<R>, R>
+  {
+    const R& ref;
+
+    constexpr explicit ExprLeaf(const R& ref) : ref(ref) {}
+    constexpr typename ExprLeaf::value_type at(int r, int c) const;
+  };
+
+  // scalar operand, broadcast to every element
+  template<typename R>
+  struct ExprScalar : Expr<ExprScalar<R>, R>
+  {
+    typename ExprScalar::value_type value;
+
+    constexpr explicit ExprScalar(typename ExprScalar::value_type value) : value(value) {}
+    constexpr typename ExprScalar::value_type at(int r, int c) const;
+  };
+
+  template<typename Op, typename E>
+  struct ExprUnary : Expr<ExprUnary<Op, E>, typename E::result_type>
+  {
+    E arg;
+
+    constexpr explicit ExprUnary(const E& arg) : arg(arg) {}
+    constexpr typename ExprUnary::value_type at(int r, int c) const;
+  };
+
+  template<typename Op, typename L, typename R>
+  struct ExprBinary : Expr<ExprBinary<Op, L, R>, typename L::result_type>
+  {
+    static_assert(std::is_same_v<typename L::result_type, typename R::result_type>, "expression operands must have the same shape");
+
+    L lhs;
+    R rhs;
+
+    constexpr ExprBinary(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs) {}
+    constexpr typename ExprBinary::value_type at(int r, int c) const;
+  };
+
+  namespace detail
+  {
+    template<typename X> constexpr bool is_expr_v = std::is_base_of_v<expr_tag, X>;
+
+    template<typename X> struct is_expr_leaf : std::false_type {};
+    template<int N, typename T> struct is_expr_leaf<Vec<N, T>> : std::true_type {};
+    template<int N, int M, typename T> struct is_expr_leaf<Mat<N, M, T>> : std::true_type {};
+    template<typename X> constexpr bool is_expr_leaf_v = is_expr_leaf<X>::value;
+
+    template<typename X, bool = is_expr_v<X>> struct expr_result { using type = X; };
+    template<typename X> struct expr_result<X, true> { using type = typename X::result_type; };
+    template<typename X> using expr_result_t = typename expr_result<X>::type;
+
+    // +, - between two operands of which at least one is an expression
+    template<typename L, typename R>
+    constexpr bool is_expr_sum_v = (is_expr_v<L> && (is_expr_v<R> || is_expr_leaf_v<R>)) || (is_expr_leaf_v<L> && is_expr_v<R>);
+
+    template<typename X>
+    constexpr bool is_expr_row()
+    {
+      if constexpr (is_expr_v<X> || is_expr_leaf_v<X>)
+        return expr_shape<expr_result_t<X>>::rows == 1;
+      else
+        return false;
+    }
+
+    // *, / of an expression by a scalar, or element-wise between Vec shaped operands
+    template<typename L, typename R>
+    constexpr bool is_expr_scale_v =
+      (is_expr_v<L> && std::is_arithmetic_v<R>) || (std::is_arithmetic_v<L> && is_expr_v<R>) ||
+      (is_expr_sum_v<L, R> && is_expr_row<L>() && is_expr_row<R>());
+
+    // wraps one side of a binary node, R is the result type of the expression
+    template<typename R, typename X>
+    constexpr auto expr_operand(const X& x)
+    {
+      if constexpr (is_expr_v<X>)
+        return x;
+      else if constexpr (is_expr_leaf_v<X>)
+        return ExprLeaf<X>(x);
+      else
+        return ExprScalar<R>(static_cast<typename expr_shape<R>::value_type>(x));
+    }
+
+    template<typename Op, typename L, typename R>
+    constexpr auto make_expr_binary(const L& lhs, const R& rhs)
+    {
+      using result_type = std::conditional_t<is_expr_v<L> || is_expr_leaf_v<L>, expr_result_t<L>, expr_result_t<R>>;
+      auto l = expr_operand<result_type>(lhs);
+      auto r = expr_operand<result_type>(rhs);
+      return ExprBinary<Op, decltype(l), decltype(r)>(l, r);
+    }
+  }
+
+#pragma endregion
+#pragma region "Expression Methods"
+  template<typename E, typename R>
+  constexpr const E& Expr<E, R>::self() const
+  {
+    return static_cast<const E&>(*this);
+  }
+
+  template<typename R>
+  constexpr typename ExprLeaf<R>::value_type ExprLeaf<R>::at(int r, int c) const
+  {
+    if constexpr (detail::expr_shape<R>::rows == 1)
+      return ref[c];
+    else
+      return ref.row[r][c];
+  }
+
+  template<typename R>
+  constexpr typename ExprScalar<R>::value_type ExprScalar<R>::at(int, int) const
+  {
+    return value;
+  }
+
+  template<typename Op, typename E>
+  constexpr typename ExprUnary<Op, E>::value_type ExprUnary<Op, E>::at(int r, int c) const
+  {
+    return Op()(arg.at(r, c));
+  }
+
+  template<typename Op, typename L, typename R>
+  constexpr typename ExprBinary<Op, L, R>::value_type ExprBinary<Op, L, R>::at(int r, int c) const
+  {
+    return Op()(lhs.at(r, c), rhs.at(r, c));
+  }
+
+  // entry point into the expression layer, small Vecs and Mats are returned as they are
+  template<int N, typename T>
+  constexpr decltype(auto) lazy(const Vec<N, T>& rhs)
+  {
+    if constexpr (N <= 4)
+      return (rhs);
+    else
+      return ExprLeaf<Vec<N, T>>(rhs);
+  }
+
+  template<int N, int M, typename T>
+  constexpr decltype(auto) lazy(const Mat<N, M, T>& rhs)
+  {
+    if constexpr (N <= 4 && M <= 4)
+      return (rhs);
+    else
+      return ExprLeaf<Mat<N, M, T>>(rhs);
+  }
+
+  // evaluates the expression into result in one pass. each element only reads the same element of
+  // the operands, so result may also appear in the expression
+  template<typename E, typename R>
+  constexpr void assign(R& result, const Expr<E, R>& expr)
+  {
+    const E& e = expr.self();
+    constexpr int rows = detail::expr_shape<R>::rows;
+    constexpr int cols = detail::expr_shape<R>::cols;
+    for (int r = 0; r < rows; r++)
+    {
+      for (int c = 0; c < cols; c++)
+      {
+        if constexpr (rows == 1)
+          result[c] = e.at(r, c);
+        else
+          result.row[r][c] = e.at(r, c);
+      }
+    }
+  }
+
+  template<typename E, typename R>
+  constexpr R eval(const Expr<E, R>& expr)
+  {
+    R result{};
+    assign(result, expr);
+    return result;
+  }
+
+  template<typename E, typename R>
+  constexpr Expr<E, R>::operator R() const
+  {
+    return eval(*this);
+  }
+
+  template<typename E, typename = std::enable_if_t<detail::is_expr_v<E>>>
+  constexpr auto operator-(const E& rhs)
+  {
+    return ExprUnary<detail::expr_neg, E>(rhs);
+  }
+
+  template<typename L, typename R, typename = std::enable_if_t<detail::is_expr_sum_v<L, R>>>
+  constexpr auto operator+(const L& lhs, const R& rhs)
+  {
+    return detail::make_expr_binary<detail::expr_add>(lhs, rhs);
+  }
+
+  template<typename L, typename R, typename = std::enable_if_t<detail::is_expr_sum_v<L, R>>>
+  constexpr auto operator-(const L& lhs, const R& rhs)
+  {
+    return detail::make_expr_binary<detail::expr_sub>(lhs, rhs);
+  }
+
+  template<typename L, typename R, typename = std::enable_if_t<detail::is_expr_scale_v<L, R>>>
+  constexpr auto operator*(const L& lhs, const R& rhs)
+  {
+    return detail::make_expr_binary<detail::expr_mul>(lhs, rhs);
+  }
+
+  template<typename L, typename R, typename = std::enable_if_t<detail::is_expr_scale_v<L, R>>>
+  constexpr auto operator/(const L& lhs, const R& rhs)
+  {
+    return detail::make_expr_binary<detail::expr_div>(lhs, rhs);
+  }
+
+#pragma endregion
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <ndv/bounds.h>
+#include <ndv/mat.h>
+#include <ndv/simd.h>
+#include <ndv/span.h>
+#include <ndv/vec.h>
+#include <ndv/vec_array.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "Frustum Definitions"
+  // View frustum as six planes (left, right, bottom, top, near, far) with inward unit normals:
+  // a point p is inside a plane when dot(plane.xyz, p) + plane.w >= 0, and that value is its
+  // distance from the plane.
+  template<typename T>
+  struct Frustum
+  {
+    Vec<4, T> planes[6];
+
+    Frustum() = default;
+    explicit Frustum(const Mat<4, 4, T>& view_projection);
+  };
+
+#pragma endregion
+#pragma region "Frustum Methods"
+  // Gribb/Hartmann extraction for a clip space of -w <= x, y, z <= w, as built by perspective()
+  // and orthographic(): each plane is the last row of the matrix plus or minus one of the others
+  template<typename T>
+  inline Frustum<T>::Frustum(const Mat<4, 4, T>& m)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      planes[2 * i] = m.row[3] + m.row[i];
+      planes[2 * i + 1] = m.row[3] - m.row[i];
+    }
+    for (Vec<4, T>& plane : planes)
+      plane /= std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+  }
+
+  template<typename T>
+  constexpr T signed_distance(const Vec<4, T>& plane, const Vec<3, T>& p)
+  {
+    return plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w;
+  }
+
+  template<typename T>
+  constexpr bool contains(const Frustum<T>& frustum, const Vec<3, type_identity_t<T>>& p)
+  {
+    for (const Vec<4, T>& plane : frustum.planes)
+      if (signed_distance(plane, p) < 0)
+        return false;
+    return true;
+  }
+
+  // conservative, like the batched tests: spheres and boxes outside the frustum but near its
+  // edges, where no single plane separates them, are reported as intersecting
+  template<typename T>
+  constexpr bool intersects_sphere(const Frustum<T>& frustum, const Vec<3, type_identity_t<T>>& center, type_identity_t<T> radius)
+  {
+    for (const Vec<4, T>& plane : frustum.planes)
+      if (signed_distance(plane, center) < -radius)
+        return false;
+    return true;
+  }
+
+  // box given by its center and half extents
+  template<typename T>
+  inline bool intersects_box(const Frustum<T>& frustum, const Vec<3, type_identity_t<T>>& center, const Vec<3, type_identity_t<T>>& extents)
+  {
+    for (const Vec<4, T>& plane : frustum.planes)
+    {
+      const T r = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+      if (signed_distance(plane, center) < -r)
+        return false;
+    }
+    return true;
+  }
+
+  template<typename T>
+  constexpr bool intersects(const Frustum<T>& frustum, const Sphere<3, T>& sphere)
+  {
+    return intersects_sphere(frustum, sphere.center, sphere.radius);
+  }
+
+  template<typename T>
+  inline bool intersects(const Frustum<T>& frustum, const AABB<3, T>& box)
+  {
+    return intersects_box(frustum, center(box), extents(box));
+  }
+
+#pragma endregion
+#pragma region "Batch Culling Methods"
+  namespace detail
+  {
+    // passes the visibility of every object to out, four at a time as a 4-bit mask with SIMD.
+    // box selects the test against extents rather than radii
+    template<bool box, typename Out>
+    inline void cull(const Frustum<float>& frustum, const VecArray<3, float>& centers, const float* radii, const VecArray<3, float>* extents, Out& out)
+    {
+      const std::size_t n = centers.size();
+      const float* cx = centers.component(0);
+      const float* cy = centers.component(1);
+      const float* cz = centers.component(2);
+      std::size_t i = 0;
+
+#if defined(NDV_SIMD_SSE)
+      __m128 px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+      for (int p = 0; p < 6; p++)
+      {
+        const Vec<4, float>& plane = frustum.planes[p];
+        px[p] = _mm_set1_ps(plane.x);
+        py[p] = _mm_set1_ps(plane.y);
+        pz[p] = _mm_set1_ps(plane.z);
+        pw[p] = _mm_set1_ps(plane.w);
+        ax[p] = _mm_set1_ps(std::abs(plane.x));
+        ay[p] = _mm_set1_ps(std::abs(plane.y));
+        az[p] = _mm_set1_ps(std::abs(plane.z));
+      }
+
+      // B blocks of four objects per pass over the planes, so the plane broadcasts (which do not
+      // all fit in registers) are loaded once per 4 * B objects. d + r < 0 for any plane rejects
+      // an object, the sign bits are or-ed across planes
+      const auto test = [&](std::size_t i, auto blocks) {
+        constexpr int B = decltype(blocks)::value;
+        __m128 x[B], y[B], z[B], e[B][3], r[B], outside[B];
+        for (int b = 0; b < B; b++)
+        {
+          const std::size_t j = i + 4 * b;
+          x[b] = _mm_load_ps(cx + j);
+          y[b] = _mm_load_ps(cy + j);
+          z[b] = _mm_load_ps(cz + j);
+          if constexpr (box)
+          {
+            for (int c = 0; c < 3; c++)
+              e[b][c] = _mm_load_ps(extents->component(c) + j);
+          }
+          else
+            r[b] = _mm_loadu_ps(radii + j);
+          outside[b] = _mm_setzero_ps();
+        }
+
+        for (int p = 0; p < 6; p++)
+        {
+          for (int b = 0; b < B; b++)
+          {
+            const __m128 d = simd::madd(px[p], x[b], simd::madd(py[p], y[b], simd::madd(pz[p], z[b], pw[p])));
+            if constexpr (box)
+              r[b] = simd::madd(ax[p], e[b][0], simd::madd(ay[p], e[b][1], _mm_mul_ps(az[p], e[b][2])));
+            outside[b] = _mm_or_ps(outside[b], _mm_cmplt_ps(_mm_add_ps(d, r[b]), _mm_setzero_ps()));
+          }
+        }
+
+        for (int b = 0; b < B; b++)
+          out.block4(i + 4 * b, ~_mm_movemask_ps(outside[b]) & 0xf);
+      };
+
+      for (; i + 8 <= n; i += 8)
+        test(i, std::integral_constant<int, 2>());
+      for (; i + 4 <= n; i += 4)
+        test(i, std::integral_constant<int, 1>());
+#endif
+
+      for (; i < n; i++)
+      {
+        const Vec<3, float> c(cx[i], cy[i], cz[i]);
+        if constexpr (box)
+          out(i, intersects_box(frustum, c, (*extents)[i]));
+        else
+          out(i, intersects_sphere(frustum, c, radii[i]));
+      }
+    }
+
+    // bit i % 64 of word i / 64, the mask is cleared up front so bits are only or-ed in
+    struct CullMaskWriter
+    {
+      std::uint64_t* words;
+      std::size_t count = 0;
+
+      CullMaskWriter(span<std::uint64_t> mask, std::size_t n) : words(mask.data())
+      {
+        std::fill(words, words + (n + 63) / 64, std::uint64_t(0));
+      }
+
+      void operator()(std::size_t i, bool visible)
+      {
+        words[i / 64] |= std::uint64_t(visible) << (i % 64);
+        count += visible;
+      }
+
+      // i is a multiple of 4, so the block never straddles two words
+      void block4(std::size_t i, int visible)
+      {
+        words[i / 64] |= std::uint64_t(visible) << (i % 64);
+        count += (visible & 1) + ((visible >> 1) & 1) + ((visible >> 2) & 1) + (visible >> 3);
+      }
+    };
+
+    // every index is written and the end only advanced past visible ones, so there is no branch
+    struct CullIndexWriter
+    {
+      std::uint32_t* indices;
+      std::size_t count = 0;
+
+      explicit CullIndexWriter(span<std::uint32_t> indices) : indices(indices.data()) {}
+
+      void operator()(std::size_t i, bool visible)
+      {
+        indices[count] = std::uint32_t(i);
+        count += visible;
+      }
+
+      void block4(std::size_t i, int visible)
+      {
+        for (int k = 0; k < 4; k++)
+          (*this)(i + k, (visible >> k) & 1);
+      }
+    };
+  }
+
+  // Batched culling of bounding spheres (SoA centers, radii) and boxes (SoA centers, half
+  // extents), four objects per step with SIMD. The results go either to a bitmask of (n + 63) / 64
+  // words, with bit i % 64 of word i / 64 set for a visible object, or to a compacted list of the
+  // visible indices in increasing order, which needs room for n entries. Both return the number
+  // of visible objects.
+  inline std::size_t cull_spheres(const Frustum<float>& frustum, const VecArray<3, float>& centers, span<const float> radii, span<std::uint64_t> visible_mask)
+  {
+    assert(radii.size() == centers.size() && visible_mask.size() >= (centers.size() + 63) / 64);
+    detail::CullMaskWriter out(visible_mask, centers.size());
+    detail::cull<false>(frustum, centers, radii.data(), nullptr, out);
+    return out.count;
+  }
+
+  inline std::size_t cull_spheres(const Frustum<float>& frustum, const VecArray<3, float>& centers, span<const float> radii, span<std::uint32_t> visible_indices)
+  {
+    assert(radii.size() == centers.size() && visible_indices.size() >= centers.size());
+    detail::CullIndexWriter out(visible_indices);
+    detail::cull<false>(frustum, centers, radii.data(), nullptr, out);
+    return out.count;
+  }
+
+  inline std::size_t cull_boxes(const Frustum<float>& frustum, const VecArray<3, float>& centers, const VecArray<3, float>& extents, span<std::uint64_t> visible_mask)
+  {
+    assert(extents.size() == centers.size() && visible_mask.size() >= (centers.size() + 63) / 64);
+    detail::CullMaskWriter out(visible_mask, centers.size());
+    detail::cull<true>(frustum, centers, nullptr, &extents, out);
+    return out.count;
+  }
+
+  inline std::size_t cull_boxes(const Frustum<float>& frustum, const VecArray<3, float>& centers, const VecArray<3, float>& extents, span<std::uint32_t> visible_indices)
+  {
+    assert(extents.size() == centers.size() && visible_indices.size() >= centers.size());
+    detail::CullIndexWriter out(visible_indices);
+    detail::cull<true>(frustum, centers, nullptr, &extents, out);
+    return out.count;
+  }
+
+#pragma endregion
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <ndv/execution.h>
+#include <ndv/mat.h>
+#include <ndv/span.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ndv
+{
+#pragma region "TransformHierarchy Definitions"
+  // Local to world matrix propagation for a tree of nodes. Nodes are added parents first, so the
+  // parent, local and world arrays are topologically sorted and a single forward pass sees every
+  // parent before its children. set_local only marks the node dirty, update() then recomputes the
+  // world matrices of the dirty nodes and their subtrees, world = world(parent) * local, and
+  // leaves the others alone. world() is the contiguous result, indexed by node, for upload.
+  class TransformHierarchy
+  {
+  public:
+    static constexpr std::uint32_t no_parent = ~std::uint32_t(0);
+
+    TransformHierarchy() = default;
+
+    std::size_t size() const { return parents.size(); }
+    bool empty() const { return parents.empty(); }
+    void reserve(std::size_t n);
+    void clear();
+
+    // parent must be an existing node or no_parent for a root, returns the new node
+    std::uint32_t add(std::uint32_t parent, const Mat<4, 4, float>& local = Mat<4, 4, float>::identity);
+
+    std::uint32_t parent(std::uint32_t node) const { return parents[node]; }
+    const Mat<4, 4, float>& local(std::uint32_t node) const { return locals[node]; }
+    void set_local(std::uint32_t node, const Mat<4, 4, float>& local);
+
+    // current as of the last update()
+    const Mat<4, 4, float>& world(std::uint32_t node) const { return worlds[node]; }
+    span<const Mat<4, 4, float>> world() const { return span<const Mat<4, 4, float>>(worlds.data(), worlds.size()); }
+
+    // recomputes the world matrices below dirty nodes and returns how many were recomputed. under
+    // an execution policy the nodes of each depth, which only depend on the depth above, are
+    // split across the executor
+    std::size_t update();
+    template<typename Policy, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+    std::size_t update(const Policy& policy);
+
+  private:
+    // nodes[begin, end), or the nodes begin to end themselves when nodes is null
+    // returns how many of them were recomputed
+    std::size_t update_range(const std::uint32_t* nodes, std::size_t begin, std::size_t end);
+    void finish_update();
+
+    std::vector<std::uint32_t> parents;
+    std::vector<Mat<4, 4, float>> locals;
+    std::vector<Mat<4, 4, float>> worlds;
+    // set by set_local and add, then for the subtrees below during update
+    std::vector<std::uint8_t> dirty;
+    // the nodes of each depth in increasing order, depth 0 are the roots
+    std::vector<std::vector<std::uint32_t>> levels;
+    std::vector<std::uint32_t> depths;
+    // nodes before it are clean, children always come after their parents
+    std::size_t first_dirty = 0;
+  };
+
+#pragma endregion
+#pragma region "TransformHierarchy Methods"
+  inline void TransformHierarchy::reserve(std::size_t n)
+  {
+    parents.reserve(n);
+    locals.reserve(n);
+    worlds.reserve(n);
+    dirty.reserve(n);
+    depths.reserve(n);
+  }
+
+  inline void TransformHierarchy::clear()
+  {
+    parents.clear();
+    locals.clear();
+    worlds.clear();
+    dirty.clear();
+    levels.clear();
+    depths.clear();
+    first_dirty = 0;
+  }
+
+  inline std::uint32_t TransformHierarchy::add(std::uint32_t parent, const Mat<4, 4, float>& local)
+  {
+    assert(parent == no_parent || parent < size());
+    const std::uint32_t node = std::uint32_t(size());
+    const std::uint32_t depth = parent == no_parent ? 0 : depths[parent] + 1;
+    if (depth == levels.size())
+      levels.emplace_back();
+    levels[depth].push_back(node);
+
+    parents.push_back(parent);
+    locals.push_back(local);
+    worlds.push_back(local);
+    dirty.push_back(1);
+    depths.push_back(depth);
+    first_dirty = std::min<std::size_t>(first_dirty, node);
+    return node;
+  }
+
+  inline void TransformHierarchy::set_local(std::uint32_t node, const Mat<4, 4, float>& local)
+  {
+    assert(node < size());
+    locals[node] = local;
+    dirty[node] = 1;
+    first_dirty = std::min<std::size_t>(first_dirty, node);
+  }
+
+  // the parent is final by the time its children are reached, flag and world matrix alike. the
+  // arrays are read through local pointers, since the byte stores to the flags could otherwise
+  // alias the vectors and force them to be reloaded for every node
+  inline std::size_t TransformHierarchy::update_range(const std::uint32_t* nodes, std::size_t begin, std::size_t end)
+  {
+    const std::uint32_t* parent = parents.data();
+    const Mat<4, 4, float>* local = locals.data();
+    Mat<4, 4, float>* world = worlds.data();
+    std::uint8_t* flags = dirty.data();
+    std::size_t count = 0;
+    for (std::size_t k = begin; k < end; k++)
+    {
+      const std::size_t i = nodes ? nodes[k] : k;
+      const std::uint32_t p = parent[i];
+      if (p == no_parent)
+      {
+        if (flags[i])
+        {
+          world[i] = local[i];
+          count++;
+        }
+      }
+      else if (flags[i] | flags[p])
+      {
+        flags[i] = 1;
+        world[i] = world[p] * local[i];
+        count++;
+      }
+    }
+    return count;
+  }
+
+  // the flags are only cleared once every child has seen its parent's
+  inline void TransformHierarchy::finish_update()
+  {
+    std::fill(dirty.begin() + first_dirty, dirty.end(), std::uint8_t(0));
+    first_dirty = size();
+  }
+
+  inline std::size_t TransformHierarchy::update()
+  {
+    const std::size_t count = update_range(nullptr, first_dirty, size());
+    finish_update();
+    return count;
+  }
+
+  template<typename Policy, typename>
+  inline std::size_t TransformHierarchy::update(const Policy& policy)
+  {
+    // the level walk only pays off with threads to spread it over, the linear pass reads the
+    // arrays in order
+    if constexpr (std::is_same_v<Policy, SequencedPolicy>)
+      return update();
+    else if constexpr (std::is_same_v<Policy, ParallelPolicy>)
+    {
+      if (ThreadPool::instance().size() == 0)
+        return update();
+    }
+    if (first_dirty == size())
+      return 0;
+
+    // a node reads its parent and writes only itself, so the nodes of one depth are independent
+    const std::size_t block = detail::block_size(3 * sizeof(Mat<4, 4, float>));
+    std::atomic<std::size_t> count{0};
+    for (const std::vector<std::uint32_t>& level : levels)
+    {
+      // nodes before first_dirty are clean and stay so
+      const std::size_t begin = std::lower_bound(level.begin(), level.end(), std::uint32_t(first_dirty)) - level.begin();
+      detail::for_each_block(policy, level.size() - begin, block, [&](std::size_t b, std::size_t e) {
+        count.fetch_add(update_range(level.data(), begin + b, begin + e), std::memory_order_relaxed);
+      });
+    }
+
+    finish_update();
+    return count.load(std::memory_order_relaxed);
+  }
+
+#pragma endregion
+}
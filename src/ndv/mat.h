@@ -2,10 +2,13 @@
 
 #include <ndv/vec.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <initializer_list>
+#include <limits>
 #include <type_traits>
+#include <utility>
 
 namespace ndv
 {
@@ -20,24 +23,23 @@ namespace ndv
       T data[N][M];
     };
 
-    static Mat diag(T diag_val);
-    static Mat full(T fill_val);
+    static constexpr Mat diag(T diag_val);
+    static constexpr Mat full(T fill_val);
     static const Mat identity;
     static const Mat zero;
 
     Mat() = default;
-    Mat(const std::initializer_list<T> args);
-    Mat(const std::initializer_list<std::initializer_list<T>> args);
-
-    const Vec<N, T>& operator[](int i) const;
-    Vec<N, T>& operator[](int i);
-
-    Mat& operator=(const Mat& rhs);
-    Mat& operator+=(const Mat& rhs);
-    Mat& operator-=(const Mat& rhs);
-    Mat& operator*=(const Mat& rhs);
-    Mat& operator*=(T rhs);
-    Mat& operator/=(T rhs);
+    constexpr Mat(const std::initializer_list<T> args);
+    constexpr Mat(const std::initializer_list<std::initializer_list<T>> args);
+
+    constexpr const Vec<M, T>& operator[](int i) const;
+    constexpr Vec<M, T>& operator[](int i);
+
+    constexpr Mat& operator+=(const Mat& rhs);
+    constexpr Mat& operator-=(const Mat& rhs);
+    constexpr Mat& operator*=(const Mat& rhs);
+    constexpr Mat& operator*=(T rhs);
+    constexpr Mat& operator/=(T rhs);
   };
 
   // prevent 1-dimensional matrices
@@ -54,24 +56,23 @@ namespace ndv
       T data[2][2];
     };
 
-    static Mat diag(T diag_val);
-    static Mat full(T fill_val);
+    static constexpr Mat diag(T diag_val);
+    static constexpr Mat full(T fill_val);
     static const Mat identity;
     static const Mat zero;
 
     Mat() = default;
-    Mat(const std::initializer_list<T> args);
-    Mat(const std::initializer_list<std::initializer_list<T>> args);
-
-    const Vec<2, T>& operator[](int i) const;
-    Vec<2, T>& operator[](int i);
-
-    Mat& operator=(const Mat& rhs);
-    Mat& operator+=(const Mat& rhs);
-    Mat& operator-=(const Mat& rhs);
-    Mat& operator*=(const Mat& rhs);
-    Mat& operator*=(T rhs);
-    Mat& operator/=(T rhs);
+    constexpr Mat(const std::initializer_list<T> args);
+    constexpr Mat(const std::initializer_list<std::initializer_list<T>> args);
+
+    constexpr const Vec<2, T>& operator[](int i) const;
+    constexpr Vec<2, T>& operator[](int i);
+
+    constexpr Mat& operator+=(const Mat& rhs);
+    constexpr Mat& operator-=(const Mat& rhs);
+    constexpr Mat& operator*=(const Mat& rhs);
+    constexpr Mat& operator*=(T rhs);
+    constexpr Mat& operator/=(T rhs);
   };
   using Mat2 = Mat<2, 2, float>;
   using Mat2i = Mat<2, 2, int>;
@@ -86,24 +87,23 @@ namespace ndv
       T data[3][3];
     };
 
-    static Mat diag(T diag_val);
-    static Mat full(T fill_val);
+    static constexpr Mat diag(T diag_val);
+    static constexpr Mat full(T fill_val);
     static const Mat identity;
     static const Mat zero;
 
     Mat() = default;
-    Mat(const std::initializer_list<T> args);
-    Mat(const std::initializer_list<std::initializer_list<T>> args);
-
-    const Vec<3, T>& operator[](int i) const;
-    Vec<3, T>& operator[](int i);
-
-    Mat& operator=(const Mat& rhs);
-    Mat& operator+=(const Mat& rhs);
-    Mat& operator-=(const Mat& rhs);
-    Mat& operator*=(const Mat& rhs);
-    Mat& operator*=(T rhs);
-    Mat& operator/=(T rhs);
+    constexpr Mat(const std::initializer_list<T> args);
+    constexpr Mat(const std::initializer_list<std::initializer_list<T>> args);
+
+    constexpr const Vec<3, T>& operator[](int i) const;
+    constexpr Vec<3, T>& operator[](int i);
+
+    constexpr Mat& operator+=(const Mat& rhs);
+    constexpr Mat& operator-=(const Mat& rhs);
+    constexpr Mat& operator*=(const Mat& rhs);
+    constexpr Mat& operator*=(T rhs);
+    constexpr Mat& operator/=(T rhs);
   };
   using Mat3 = Mat<3, 3, float>;
   using Mat3i = Mat<3, 3, int>;
@@ -118,60 +118,75 @@ namespace ndv
       T data[4][4];
     };
 
-    static Mat diag(T diag_val);
-    static Mat full(T fill_val);
+    static constexpr Mat diag(T diag_val);
+    static constexpr Mat full(T fill_val);
     static const Mat identity;
     static const Mat zero;
 
     Mat() = default;
-    Mat(const std::initializer_list<T> args);
-    Mat(const std::initializer_list<std::initializer_list<T>> args);
-
-    const Vec<4, T>& operator[](int i) const;
-    Vec<4, T>& operator[](int i);
-
-    Mat& operator=(const Mat& rhs);
-    Mat& operator+=(const Mat& rhs);
-    Mat& operator-=(const Mat& rhs);
-    Mat& operator*=(const Mat& rhs);
-    Mat& operator*=(T rhs);
-    Mat& operator/=(T rhs);
+    constexpr Mat(const std::initializer_list<T> args);
+    constexpr Mat(const std::initializer_list<std::initializer_list<T>> args);
+
+    constexpr const Vec<4, T>& operator[](int i) const;
+    constexpr Vec<4, T>& operator[](int i);
+
+    constexpr Mat& operator+=(const Mat& rhs);
+    constexpr Mat& operator-=(const Mat& rhs);
+    constexpr Mat& operator*=(const Mat& rhs);
+    constexpr Mat& operator*=(T rhs);
+    constexpr Mat& operator/=(T rhs);
   };
   using Mat4 = Mat<4, 4, float>;
   using Mat4i = Mat<4, 4, int>;
   using Mat4d = Mat<4, 4, double>;
 
+  // affine transform stored without its implicit bottom row 0 0 0 1: the 3x3 linear block and
+  // the translation in column 3. a quarter smaller than a Mat4 and composes in 36 multiplies
+  using Affine3 = Mat<3, 4, float>;
+  using Affine3d = Mat<3, 4, double>;
+
+  // LU factorization with partial pivoting, P * A = L * U. L (unit diagonal implied) is stored
+  // below the diagonal of lu and U on and above it. row i of P * A is row perm[i] of A
+  template<int N, typename T>
+  struct LU
+  {
+    Mat<N, N, T> lu;
+    int perm[N];
+    int sign;       // determinant of P, +1 or -1
+    bool singular;
+  };
+
 #pragma endregion
 #pragma region "Base Methods"
-  template<int N, int M, typename T> Mat<N, M, T> Mat<N, M, T>::diag(T diag_val)
+  template<int N, int M, typename T> constexpr Mat<N, M, T> Mat<N, M, T>::diag(T diag_val)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = (r == c) ? diag_val : 0;
     return result;
   }
 
-  template<int N, int M, typename T> Mat<N, M, T> Mat<N, M, T>::full(T fill_val)
+  template<int N, int M, typename T> constexpr Mat<N, M, T> Mat<N, M, T>::full(T fill_val)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = fill_val;
     return result;
   }
 
-  template<int N, int M, typename T> const Mat<N, M, T> Mat<N, M, T>::identity = Mat<N, M, T>::diag(1);
-  template<int N, int M, typename T> const Mat<N, M, T> Mat<N, M, T>::zero = Mat<N, M, T>::full(0);
+  template<int N, int M, typename T> inline constexpr Mat<N, M, T> Mat<N, M, T>::identity = Mat<N, M, T>::diag(1);
+  template<int N, int M, typename T> inline constexpr Mat<N, M, T> Mat<N, M, T>::zero = Mat<N, M, T>::full(0);
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T>::Mat(const std::initializer_list<T> args)
+  constexpr Mat<N, M, T>::Mat(const std::initializer_list<T> args) : row{}
   {
     assert(args.size() <= N * M);
     int r = 0, c = 0;
     for (auto it = args.begin(); it != args.end(); ++it)
     {
-      data[r][c++] = *it;
+      row[r][c++] = *it;
       if (c >= M)
       {
         r++;
@@ -181,7 +196,7 @@ namespace ndv
   }
   
   template<int N, int M, typename T>
-  inline Mat<N, M, T>::Mat(const std::initializer_list<std::initializer_list<T>> args)
+  constexpr Mat<N, M, T>::Mat(const std::initializer_list<std::initializer_list<T>> args) : row{}
   {
     assert(args.size() <= N);
     int r = 0;
@@ -191,86 +206,78 @@ namespace ndv
       assert(args2.size() <= M);
       int c = 0;
       for (auto it2 = args2.begin(); it2 != args2.end(); ++it2)
-        data[r++][c] = *it2;
+        row[r][c++] = *it2;
       r++;
     }
   }
 
   template<int N, int M, typename T>
-  inline const Vec<N, T>& Mat<N, M, T>::operator[](int i) const
+  constexpr const Vec<M, T>& Mat<N, M, T>::operator[](int i) const
   {
     assert(i >= 0 && i < N);
     return row[i];
   }
 
   template<int N, int M, typename T>
-  inline Vec<N, T>& Mat<N, M, T>::operator[](int i)
+  constexpr Vec<M, T>& Mat<N, M, T>::operator[](int i)
   {
     assert(i >= 0 && i < N);
     return row[i];
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T>& Mat<N, M, T>::operator=(const Mat<N, M, T>& rhs)
-  {
-    for (int r = 0; r < N; r++)
-      row[r] = rhs[r];
-    return *this;
-  }
-
-  template<int N, int M, typename T>
-  inline Mat<N, M, T>& Mat<N, M, T>::operator+=(const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T>& Mat<N, M, T>::operator+=(const Mat<N, M, T>& rhs)
   {
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
-        data[r][c] += rhs[r][c];
+        row[r][c] += rhs[r][c];
     return *this;
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T>& Mat<N, M, T>::operator-=(const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T>& Mat<N, M, T>::operator-=(const Mat<N, M, T>& rhs)
   {
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
-        data[r][c] -= rhs[r][c];
+        row[r][c] -= rhs[r][c];
     return *this;
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T>& Mat<N, M, T>::operator*=(const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T>& Mat<N, M, T>::operator*=(const Mat<N, M, T>& rhs)
   {
     *this = *this * rhs;
     return *this;
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T>& Mat<N, M, T>::operator*=(T rhs)
+  constexpr Mat<N, M, T>& Mat<N, M, T>::operator*=(T rhs)
   {
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
-        data[r][c] *= rhs;
+        row[r][c] *= rhs;
     return *this;
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T>& Mat<N, M, T>::operator/=(T rhs)
+  constexpr Mat<N, M, T>& Mat<N, M, T>::operator/=(T rhs)
   {
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
-        data[r][c] /= rhs;
+        row[r][c] /= rhs;
     return *this;
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator+(const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T> operator+(const Mat<N, M, T>& rhs)
   {
     return rhs;
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator-(const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T> operator-(const Mat<N, M, T>& rhs)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = -rhs[r][c];
@@ -278,9 +285,9 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator+(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T> operator+(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = lhs[r][c] + rhs[r][c];
@@ -288,36 +295,35 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator-(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T> operator-(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = lhs[r][c] - rhs[r][c];
     return result;
   }
 
+  // each result row is accumulated from scaled rhs rows, so the inner loop runs along rows
   template<int N, int M, int O, typename T>
-  inline Mat<N, O, T> operator*(const Mat<N, M, T>& lhs, const Mat<M, O, T>& rhs)
+  constexpr Mat<N, O, T> operator*(const Mat<N, M, T>& lhs, const Mat<M, O, T>& rhs)
   {
-    Mat<N, O, T> result;
+    Mat<N, O, T> result{};
     for (int r = 0; r < N; r++)
     {
       for (int c = 0; c < O; c++)
-      {
-        T val = 0;
-        for (int i = 0; i < M; i++)
-          val += lhs[r][i] * rhs[i][c];
-        result[r][c] = val;
-      }
+        result[r][c] = lhs[r][0] * rhs[0][c];
+      for (int i = 1; i < M; i++)
+        for (int c = 0; c < O; c++)
+          result[r][c] += lhs[r][i] * rhs[i][c];
     }
     return result;
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator*(const Mat<N, M, T>& lhs, T rhs)
+  constexpr Mat<N, M, T> operator*(const Mat<N, M, T>& lhs, T rhs)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = lhs[r][c] * rhs;
@@ -325,9 +331,9 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator*(T lhs, const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T> operator*(T lhs, const Mat<N, M, T>& rhs)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = lhs * rhs[r][c];
@@ -335,9 +341,9 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline Vec<N, T> operator*(const Mat<N, M, T>& lhs, const Vec<M, T>& rhs)
+  constexpr Vec<N, T> operator*(const Mat<N, M, T>& lhs, const Vec<M, T>& rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int r = 0; r < N; r++)
     {
       T val = 0;
@@ -349,9 +355,9 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator/(const Mat<N, M, T>& lhs, T rhs)
+  constexpr Mat<N, M, T> operator/(const Mat<N, M, T>& lhs, T rhs)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = lhs[r][c] / rhs;
@@ -359,9 +365,9 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline Mat<N, M, T> operator/(T lhs, const Mat<N, M, T>& rhs)
+  constexpr Mat<N, M, T> operator/(T lhs, const Mat<N, M, T>& rhs)
   {
-    Mat<N, M, T> result;
+    Mat<N, M, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
         result[r][c] = lhs / rhs[r][c];
@@ -369,7 +375,7 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline bool operator==(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
+  constexpr bool operator==(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
   {
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
@@ -379,7 +385,7 @@ namespace ndv
   }
 
   template<int N, int M, typename T>
-  inline bool operator!=(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
+  constexpr bool operator!=(const Mat<N, M, T>& lhs, const Mat<N, M, T>& rhs)
   {
     for (int r = 0; r < N; r++)
       for (int c = 0; c < M; c++)
@@ -390,35 +396,35 @@ namespace ndv
 
 #pragma endregion
 #pragma region "Mat2 Methods"
-  template<typename T> Mat<2, 2, T> Mat<2, 2, T>::diag(T diag_val)
+  template<typename T> constexpr Mat<2, 2, T> Mat<2, 2, T>::diag(T diag_val)
   {
-    Mat<2, 2, T> result;
+    Mat<2, 2, T> result{};
     for (int r = 0; r < 2; r++)
       for (int c = 0; c < 2; c++)
         result[r][c] = (c == r) ? diag_val : 0;
     return result;
   }
 
-  template<typename T> Mat<2, 2, T> Mat<2, 2, T>::full(T fill_val)
+  template<typename T> constexpr Mat<2, 2, T> Mat<2, 2, T>::full(T fill_val)
   {
-    Mat<2, 2, T> result;
+    Mat<2, 2, T> result{};
     for (int r = 0; r < 2; r++)
       for (int c = 0; c < 2; c++)
         result[r][c] = fill_val;
     return result;
   }
 
-  template<typename T> const Mat<2, 2, T> Mat<2, 2, T>::identity = Mat<2, 2, T>::diag(1);
-  template<typename T> const Mat<2, 2, T> Mat<2, 2, T>::zero = Mat<2, 2, T>::full(0);
+  template<typename T> inline constexpr Mat<2, 2, T> Mat<2, 2, T>::identity = Mat<2, 2, T>::diag(1);
+  template<typename T> inline constexpr Mat<2, 2, T> Mat<2, 2, T>::zero = Mat<2, 2, T>::full(0);
 
   template<typename T>
-  inline Mat<2, 2, T>::Mat(const std::initializer_list<T> args)
+  constexpr Mat<2, 2, T>::Mat(const std::initializer_list<T> args) : row{}
   {
     assert(args.size() <= 4);
     int r = 0, c = 0;
     for (auto it = args.begin(); it != args.end(); ++it)
     {
-      data[r][c++] = *it;
+      row[r][c++] = *it;
       if (c >= 2)
       {
         r++;
@@ -428,7 +434,7 @@ namespace ndv
   }
   
   template<typename T>
-  inline Mat<2, 2, T>::Mat(const std::initializer_list<std::initializer_list<T>> args)
+  constexpr Mat<2, 2, T>::Mat(const std::initializer_list<std::initializer_list<T>> args) : row{}
   {
     assert(args.size() <= 2);
     int r = 0;
@@ -438,107 +444,99 @@ namespace ndv
       assert(args2.size() <= 2);
       int c = 0;
       for (auto it2 = args2.begin(); it2 != args2.end(); ++it2)
-        data[r][c++] = *it2;
+        row[r][c++] = *it2;
       r++;
     }
   }
 
   template<typename T>
-  inline const Vec<2, T>& Mat<2, 2, T>::operator[](int i) const
+  constexpr const Vec<2, T>& Mat<2, 2, T>::operator[](int i) const
   {
     assert(i >= 0 && i < 2);
     return row[i];
   }
 
   template<typename T>
-  inline Vec<2, T>& Mat<2, 2, T>::operator[](int i)
+  constexpr Vec<2, T>& Mat<2, 2, T>::operator[](int i)
   {
     assert(i >= 0 && i < 2);
     return row[i];
   }
 
   template<typename T>
-  inline Mat<2, 2, T>& Mat<2, 2, T>::operator=(const Mat<2, 2, T>& rhs)
-  {
-    for (int r = 0; r < 2; r++)
-      row[r] = rhs[r];
-    return *this;
-  }
-
-  template<typename T>
-  inline Mat<2, 2, T>& Mat<2, 2, T>::operator+=(const Mat<2, 2, T>& rhs)
+  constexpr Mat<2, 2, T>& Mat<2, 2, T>::operator+=(const Mat<2, 2, T>& rhs)
   {
     for (int r = 0; r < 2; r++)
       for (int c = 0; c < 2; c++)
-        data[r][c] += rhs[r][c];
+        row[r][c] += rhs[r][c];
     return *this;
   }
 
   template<typename T>
-  inline Mat<2, 2, T>& Mat<2, 2, T>::operator-=(const Mat<2, 2, T>& rhs)
+  constexpr Mat<2, 2, T>& Mat<2, 2, T>::operator-=(const Mat<2, 2, T>& rhs)
   {
     for (int r = 0; r < 2; r++)
       for (int c = 0; c < 2; c++)
-        data[r][c] -= rhs[r][c];
+        row[r][c] -= rhs[r][c];
     return *this;
   }
 
   template<typename T>
-  inline Mat<2, 2, T>& Mat<2, 2, T>::operator*=(const Mat<2, 2, T>& rhs)
+  constexpr Mat<2, 2, T>& Mat<2, 2, T>::operator*=(const Mat<2, 2, T>& rhs)
   {
     *this = *this * rhs;
     return *this;
   }
 
   template<typename T>
-  inline Mat<2, 2, T>& Mat<2, 2, T>::operator*=(T rhs)
+  constexpr Mat<2, 2, T>& Mat<2, 2, T>::operator*=(T rhs)
   {
     for (int r = 0; r < 2; r++)
       for (int c = 0; c < 2; c++)
-        data[r][c] *= rhs;
+        row[r][c] *= rhs;
     return *this;
   }
 
   template<typename T>
-  inline Mat<2, 2, T>& Mat<2, 2, T>::operator/=(T rhs)
+  constexpr Mat<2, 2, T>& Mat<2, 2, T>::operator/=(T rhs)
   {
     for (int r = 0; r < 2; r++)
       for (int c = 0; c < 2; c++)
-        data[r][c] /= rhs;
+        row[r][c] /= rhs;
     return *this;
   }
 
 #pragma endregion
 #pragma region "Mat3 Methods"
-  template<typename T> Mat<3, 3, T> Mat<3, 3, T>::diag(T diag_val)
+  template<typename T> constexpr Mat<3, 3, T> Mat<3, 3, T>::diag(T diag_val)
   {
-    Mat<3, 3, T> result;
+    Mat<3, 3, T> result{};
     for (int r = 0; r < 3; r++)
       for (int c = 0; c < 3; c++)
         result[r][c] = (c == r) ? diag_val : 0;
     return result;
   }
 
-  template<typename T> Mat<3, 3, T> Mat<3, 3, T>::full(T fill_val)
+  template<typename T> constexpr Mat<3, 3, T> Mat<3, 3, T>::full(T fill_val)
   {
-    Mat<3, 3, T> result;
+    Mat<3, 3, T> result{};
     for (int r = 0; r < 3; r++)
       for (int c = 0; c < 3; c++)
         result[r][c] = fill_val;
     return result;
   }
 
-  template<typename T> const Mat<3, 3, T> Mat<3, 3, T>::identity = Mat<3, 3, T>::diag(1);
-  template<typename T> const Mat<3, 3, T> Mat<3, 3, T>::zero = Mat<3, 3, T>::full(0);
+  template<typename T> inline constexpr Mat<3, 3, T> Mat<3, 3, T>::identity = Mat<3, 3, T>::diag(1);
+  template<typename T> inline constexpr Mat<3, 3, T> Mat<3, 3, T>::zero = Mat<3, 3, T>::full(0);
 
   template<typename T>
-  inline Mat<3, 3, T>::Mat(const std::initializer_list<T> args)
+  constexpr Mat<3, 3, T>::Mat(const std::initializer_list<T> args) : row{}
   {
     assert(args.size() <= 9);
     int r = 0, c = 0;
     for (auto it = args.begin(); it != args.end(); ++it)
     {
-      data[r][c++] = *it;
+      row[r][c++] = *it;
       if (c >= 3)
       {
         r++;
@@ -548,7 +546,7 @@ namespace ndv
   }
   
   template<typename T>
-  inline Mat<3, 3, T>::Mat(const std::initializer_list<std::initializer_list<T>> args)
+  constexpr Mat<3, 3, T>::Mat(const std::initializer_list<std::initializer_list<T>> args) : row{}
   {
     assert(args.size() <= 3);
     int r = 0;
@@ -558,117 +556,109 @@ namespace ndv
       assert(args2.size() <= 3);
       int c = 0;
       for (auto it2 = args2.begin(); it2 != args2.end(); ++it2)
-        data[r][c++] = *it2;
+        row[r][c++] = *it2;
       r++;
     }
   }
 
   template<typename T>
-  inline const Vec<3, T>& Mat<3, 3, T>::operator[](int i) const
+  constexpr const Vec<3, T>& Mat<3, 3, T>::operator[](int i) const
   {
     assert(i >= 0 && i < 3);
     return row[i];
   }
 
   template<typename T>
-  inline Vec<3, T>& Mat<3, 3, T>::operator[](int i)
+  constexpr Vec<3, T>& Mat<3, 3, T>::operator[](int i)
   {
     assert(i >= 0 && i < 3);
     return row[i];
   }
 
   template<typename T>
-  inline Mat<3, 3, T>& Mat<3, 3, T>::operator=(const Mat<3, 3, T>& rhs)
-  {
-    for (int r = 0; r < 3; r++)
-      row[r] = rhs[r];
-    return *this;
-  }
-
-  template<typename T>
-  inline Mat<3, 3, T>& Mat<3, 3, T>::operator+=(const Mat<3, 3, T>& rhs)
+  constexpr Mat<3, 3, T>& Mat<3, 3, T>::operator+=(const Mat<3, 3, T>& rhs)
   {
     for (int r = 0; r < 3; r++)
       for (int c = 0; c < 3; c++)
-        data[r][c] += rhs[r][c];
+        row[r][c] += rhs[r][c];
     return *this;
   }
 
   template<typename T>
-  inline Mat<3, 3, T>& Mat<3, 3, T>::operator-=(const Mat<3, 3, T>& rhs)
+  constexpr Mat<3, 3, T>& Mat<3, 3, T>::operator-=(const Mat<3, 3, T>& rhs)
   {
     for (int r = 0; r < 3; r++)
       for (int c = 0; c < 3; c++)
-        data[r][c] -= rhs[r][c];
+        row[r][c] -= rhs[r][c];
     return *this;
   }
 
   template<typename T>
-  inline Mat<3, 3, T>& Mat<3, 3, T>::operator*=(const Mat<3, 3, T>& rhs)
+  constexpr Mat<3, 3, T>& Mat<3, 3, T>::operator*=(const Mat<3, 3, T>& rhs)
   {
     *this = *this * rhs;
     return *this;
   }
 
   template<typename T>
-  inline Mat<3, 3, T>& Mat<3, 3, T>::operator*=(T rhs)
+  constexpr Mat<3, 3, T>& Mat<3, 3, T>::operator*=(T rhs)
   {
     for (int r = 0; r < 3; r++)
       for (int c = 0; c < 3; c++)
-        data[r][c] *= rhs;
+        row[r][c] *= rhs;
     return *this;
   }
 
   template<typename T>
-  inline Mat<3, 3, T>& Mat<3, 3, T>::operator/=(T rhs)
+  constexpr Mat<3, 3, T>& Mat<3, 3, T>::operator/=(T rhs)
   {
     for (int r = 0; r < 3; r++)
       for (int c = 0; c < 3; c++)
-        data[r][c] /= rhs;
+        row[r][c] /= rhs;
     return *this;
   }
 
 #pragma endregion
 #pragma region "Mat4 Methods"
-  template<typename T> Mat<4, 4, T> Mat<4, 4, T>::diag(T diag_val)
+  template<typename T> constexpr Mat<4, 4, T> Mat<4, 4, T>::diag(T diag_val)
   {
-    Mat<4, 4, T> result;
+    Mat<4, 4, T> result{};
     for (int r = 0; r < 4; r++)
       for (int c = 0; c < 4; c++)
         result[r][c] = (c == r) ? diag_val : 0;
     return result;
   }
 
-  template<typename T> Mat<4, 4, T> Mat<4, 4, T>::full(T fill_val)
+  template<typename T> constexpr Mat<4, 4, T> Mat<4, 4, T>::full(T fill_val)
   {
-    Mat<4, 4, T> result;
+    Mat<4, 4, T> result{};
     for (int r = 0; r < 4; r++)
       for (int c = 0; c < 4; c++)
         result[r][c] = fill_val;
     return result;
   }
   
-  template<typename T> const Mat<4, 4, T> Mat<4, 4, T>::identity = Mat<4, 4, T>::diag(1);
-  template<typename T> const Mat<4, 4, T> Mat<4, 4, T>::zero = Mat<4, 4, T>::full(0);
+  template<typename T> inline constexpr Mat<4, 4, T> Mat<4, 4, T>::identity = Mat<4, 4, T>::diag(1);
+  template<typename T> inline constexpr Mat<4, 4, T> Mat<4, 4, T>::zero = Mat<4, 4, T>::full(0);
 
   template<typename T>
-  inline Mat<4, 4, T>::Mat(const std::initializer_list<T> args)
+  constexpr Mat<4, 4, T>::Mat(const std::initializer_list<T> args) : row{}
   {
     assert(args.size() <= 16);
     int c = 0, r = 0;
     for (auto it = args.begin(); it != args.end(); ++it)
     {
-      data[r][c++] = *it;
+      row[r][c++] = *it;
       if (c >= 4)
       {
-        c++;
-        r = 0;
+        r++;
+        c = 0;
       }
     }
   }
   
   template<typename T>
-  inline Mat<4, 4, T>::Mat(const std::initializer_list<std::initializer_list<T>> args)
+  constexpr Mat<4, 4, T>::Mat(const std::initializer_list<std::initializer_list<T>> args) : row{}
   {
     assert(args.size() <= 4);
     int r = 0;
@@ -678,96 +668,97 @@ namespace ndv
       assert(args2.size() <= 4);
       int c = 0;
       for (auto it2 = args2.begin(); it2 != args2.end(); ++it2)
-        data[r][c++] = *it2;
+        row[r][c++] = *it2;
       r++;
     }
   }
 
   template<typename T>
-  inline const Vec<4, T>& Mat<4, 4, T>::operator[](int i) const
+  constexpr const Vec<4, T>& Mat<4, 4, T>::operator[](int i) const
   {
     assert(i >= 0 && i < 4);
     return row[i];
   }
 
   template<typename T>
-  inline Vec<4, T>& Mat<4, 4, T>::operator[](int i)
+  constexpr Vec<4, T>& Mat<4, 4, T>::operator[](int i)
   {
     assert(i >= 0 && i < 4);
     return row[i];
   }
 
   template<typename T>
-  inline Mat<4, 4, T>& Mat<4, 4, T>::operator=(const Mat<4, 4, T>& rhs)
+  constexpr Mat<4, 4, T>& Mat<4, 4, T>::operator+=(const Mat<4, 4, T>& rhs)
   {
     for (int r = 0; r < 4; r++)
-      row[r] = rhs[r];
+      for (int c = 0; c < 4; c++)
+        row[r][c] += rhs[r][c];
     return *this;
   }
 
   template<typename T>
-  inline Mat<4, 4, T>& Mat<4, 4, T>::operator+=(const Mat<4, 4, T>& rhs)
+  constexpr Mat<4, 4, T>& Mat<4, 4, T>::operator-=(const Mat<4, 4, T>& rhs)
   {
     for (int r = 0; r < 4; r++)
       for (int c = 0; c < 4; c++)
-        data[r][c] += rhs[r][c];
+        row[r][c] -= rhs[r][c];
     return *this;
   }
 
   template<typename T>
-  inline Mat<4, 4, T>& Mat<4, 4, T>::operator-=(const Mat<4, 4, T>& rhs)
+  constexpr Mat<4, 4, T>& Mat<4, 4, T>::operator*=(const Mat<4, 4, T>& rhs)
   {
+    if (&rhs == this)
+      return (*this = *this * rhs);
+
+    // rows are independent, so each one can be replaced in place
     for (int r = 0; r < 4; r++)
+    {
+      const T a0 = row[r][0], a1 = row[r][1], a2 = row[r][2], a3 = row[r][3];
       for (int c = 0; c < 4; c++)
-        data[r][c] -= rhs[r][c];
-    return *this;
-  }
-
-  template<typename T>
-  inline Mat<4, 4, T>& Mat<4, 4, T>::operator*=(const Mat<4, 4, T>& rhs)
-  {
-    *this = *this * rhs;
+        row[r][c] = a0 * rhs[0][c] + a1 * rhs[1][c] + a2 * rhs[2][c] + a3 * rhs[3][c];
+    }
     return *this;
   }
 
   template<typename T>
-  inline Mat<4, 4, T>& Mat<4, 4, T>::operator*=(T rhs)
+  constexpr Mat<4, 4, T>& Mat<4, 4, T>::operator*=(T rhs)
   {
     for (int r = 0; r < 4; r++)
       for (int c = 0; c < 4; c++)
-        data[r][c] *= rhs;
+        row[r][c] *= rhs;
     return *this;
   }
 
   template<typename T>
-  inline Mat<4, 4, T>& Mat<4, 4, T>::operator/=(T rhs)
+  constexpr Mat<4, 4, T>& Mat<4, 4, T>::operator/=(T rhs)
   {
     for (int r = 0; r < 4; r++)
       for (int c = 0; c < 4; c++)
-        data[r][c] /= rhs;
+        row[r][c] /= rhs;
     return *this;
   }
 
 #pragma endregion
 #pragma region "Utility Methods"
   template<int N, int M, typename T>
-  inline Mat<N, M, T> transpose(const Mat<N, M, T>& rhs)
+  constexpr Mat<M, N, T> transpose(const Mat<N, M, T>& rhs)
   {
-    Mat<N, M, T> result;
-    for (int r = 0; r < N; r++)
-      for (int c = 0; c < M; c++)
+    Mat<M, N, T> result{};
+    for (int r = 0; r < M; r++)
+      for (int c = 0; c < N; c++)
         result[r][c] = rhs[c][r];
     return result;
   }
 
   // returns the submatrix obtained by removing row, col
   template<int N, typename T>
-  inline Mat<N-1, N-1, T> submatrix(const Mat<N, N, T>& rhs, int row, int col)
+  constexpr Mat<N-1, N-1, T> submatrix(const Mat<N, N, T>& rhs, int row, int col)
   {
     assert(row >= 0 && row < N);
     assert(col >= 0 && col < N);
 
-    Mat<N-1, N-1, T> result;
+    Mat<N-1, N-1, T> result{};
     int i = 0, j = 0;
     for (int r = 0; r < N; r++)
     {
@@ -787,7 +778,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Mat<2, 2, T> cofactor(const Mat<2, 2, T>& rhs)
+  constexpr Mat<2, 2, T> cofactor(const Mat<2, 2, T>& rhs)
   {
     return Mat<2, 2, T>({
       {rhs[1][1], -rhs[0][1]},
@@ -796,9 +787,9 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Mat<N, N, T> cofactor(const Mat<N, N, T>& rhs)
+  constexpr Mat<N, N, T> cofactor(const Mat<N, N, T>& rhs)
   {
-    Mat<N, N, T> result;
+    Mat<N, N, T> result{};
     for (int r = 0; r < N; r++)
       for (int c = 0; c < N; c++)
         result[r][c] = (1 - 2 * ((r + c) % 2)) * determinant(submatrix(rhs, r, c));
@@ -806,19 +797,19 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Mat<N, N, T> adjoint(const Mat<N, N, T>& rhs)
+  constexpr Mat<N, N, T> adjoint(const Mat<N, N, T>& rhs)
   {
     return transpose(cofactor(rhs));
   }
 
   template<typename T>
-  inline T determinant(const Mat<2, 2, T>& rhs)
+  constexpr T determinant(const Mat<2, 2, T>& rhs)
   {
     return (rhs[0][0] * rhs[1][1] - rhs[0][1] * rhs[1][0]);
   }
 
   template<typename T>
-  inline T determinant(const Mat<3, 3, T>& rhs)
+  constexpr T determinant(const Mat<3, 3, T>& rhs)
   {
     return (
       rhs[0][0] * (rhs[1][1] * rhs[2][2] - rhs[2][1] * rhs[1][2]) -
@@ -827,54 +818,348 @@ namespace ndv
     );
   }
 
-  // generic determinant method (slow). currently gets called for 4x4 matrices
+  // expands along the 2x2 minors of rows 0-1 (s) and their complements in rows 2-3 (c)
+  template<typename T>
+  constexpr T determinant(const Mat<4, 4, T>& rhs)
+  {
+    const T s0 = rhs[0][0] * rhs[1][1] - rhs[1][0] * rhs[0][1];
+    const T s1 = rhs[0][0] * rhs[1][2] - rhs[1][0] * rhs[0][2];
+    const T s2 = rhs[0][0] * rhs[1][3] - rhs[1][0] * rhs[0][3];
+    const T s3 = rhs[0][1] * rhs[1][2] - rhs[1][1] * rhs[0][2];
+    const T s4 = rhs[0][1] * rhs[1][3] - rhs[1][1] * rhs[0][3];
+    const T s5 = rhs[0][2] * rhs[1][3] - rhs[1][2] * rhs[0][3];
+
+    const T c5 = rhs[2][2] * rhs[3][3] - rhs[3][2] * rhs[2][3];
+    const T c4 = rhs[2][1] * rhs[3][3] - rhs[3][1] * rhs[2][3];
+    const T c3 = rhs[2][1] * rhs[3][2] - rhs[3][1] * rhs[2][2];
+    const T c2 = rhs[2][0] * rhs[3][3] - rhs[3][0] * rhs[2][3];
+    const T c1 = rhs[2][0] * rhs[3][2] - rhs[3][0] * rhs[2][2];
+    const T c0 = rhs[2][0] * rhs[3][1] - rhs[3][0] * rhs[2][1];
+
+    return (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+  }
+
+  // factors rhs with partial pivoting. returns false, and sets result.singular, as soon as a
+  // pivot column has no entry above N * epsilon * max|rhs|. result is then only partly factored
+  template<int N, typename T>
+  constexpr bool lu_decompose(const Mat<N, N, T>& rhs, LU<N, T>& result)
+  {
+    static_assert(std::is_floating_point_v<T>, "lu_decompose requires a floating point type");
+
+    Mat<N, N, T>& a = result.lu;
+    a = rhs;
+    result.sign = 1;
+    result.singular = false;
+
+    T scale = 0;
+    for (int r = 0; r < N; r++)
+    {
+      result.perm[r] = r;
+      for (int c = 0; c < N; c++)
+      {
+        const T val = (a[r][c] < 0) ? -a[r][c] : a[r][c];
+        if (val > scale)
+          scale = val;
+      }
+    }
+    const T tolerance = N * std::numeric_limits<T>::epsilon() * scale;
+
+    for (int k = 0; k < N; k++)
+    {
+      int pivot = k;
+      T pivot_abs = (a[k][k] < 0) ? -a[k][k] : a[k][k];
+      for (int r = k + 1; r < N; r++)
+      {
+        const T val = (a[r][k] < 0) ? -a[r][k] : a[r][k];
+        if (val > pivot_abs)
+        {
+          pivot = r;
+          pivot_abs = val;
+        }
+      }
+
+      if (pivot_abs <= tolerance)
+      {
+        result.singular = true;
+        return false;
+      }
+
+      if (pivot != k)
+      {
+        for (int c = 0; c < N; c++)
+        {
+          const T tmp = a[k][c];
+          a[k][c] = a[pivot][c];
+          a[pivot][c] = tmp;
+        }
+        const int tmp = result.perm[k];
+        result.perm[k] = result.perm[pivot];
+        result.perm[pivot] = tmp;
+        result.sign = -result.sign;
+      }
+
+      const T inv_pivot = 1 / a[k][k];
+      for (int r = k + 1; r < N; r++)
+      {
+        const T f = a[r][k] * inv_pivot;
+        a[r][k] = f;
+        for (int c = k + 1; c < N; c++)
+          a[r][c] -= f * a[k][c];
+      }
+    }
+    return true;
+  }
+
+  // solves A * x = b, where lu is the non-singular factorization of A
+  template<int N, typename T>
+  constexpr Vec<N, T> lu_solve(const LU<N, T>& lu, const Vec<N, T>& b)
+  {
+    assert(!lu.singular);
+    const Mat<N, N, T>& a = lu.lu;
+
+    // L * y = P * b
+    Vec<N, T> x{};
+    for (int r = 0; r < N; r++)
+    {
+      T val = b[lu.perm[r]];
+      for (int c = 0; c < r; c++)
+        val -= a[r][c] * x[c];
+      x[r] = val;
+    }
+
+    // U * x = y
+    for (int r = N - 1; r >= 0; r--)
+    {
+      T val = x[r];
+      for (int c = r + 1; c < N; c++)
+        val -= a[r][c] * x[c];
+      x[r] = val / a[r][r];
+    }
+    return x;
+  }
+
+  template<int N, typename T>
+  constexpr T determinant(const LU<N, T>& lu)
+  {
+    if (lu.singular)
+      return 0;
+
+    T result = T(lu.sign);
+    for (int i = 0; i < N; i++)
+      result *= lu.lu[i][i];
+    return result;
+  }
+
+  // inverse column by column from the factorization, zero if it is singular
+  template<int N, typename T>
+  constexpr Mat<N, N, T> inverse(const LU<N, T>& lu)
+  {
+    if (lu.singular)
+      return Mat<N, N, T>::zero;
+
+    Mat<N, N, T> result{};
+    for (int c = 0; c < N; c++)
+    {
+      Vec<N, T> e(0);
+      e[c] = 1;
+      const Vec<N, T> x = lu_solve(lu, e);
+      for (int r = 0; r < N; r++)
+        result[r][c] = x[r];
+    }
+    return result;
+  }
+
+  // solves rhs * x = b. returns the zero vector when rhs is singular, call lu_decompose directly
+  // to tell the two apart or to reuse the factorization for several right-hand sides
   template<int N, typename T>
-  inline T determinant(const Mat<N, N, T>& rhs)
+  constexpr Vec<N, T> solve(const Mat<N, N, T>& rhs, const Vec<N, T>& b)
+  {
+    LU<N, T> lu{};
+    if (!lu_decompose(rhs, lu))
+      return Vec<N, T>(0);
+    return lu_solve(lu, b);
+  }
+
+  // cofactor expansion along the first row down to the closed-form 4x4, O(N!)
+  template<int N, typename T>
+  constexpr T determinant_laplace(const Mat<N, N, T>& rhs)
   {
     T result = 0;
     for (int c = 0; c < N; c++)
-      result += (1 - 2 * (c % 2)) * rhs[0][c] * determinant(submatrix(rhs, 0, c));
+    {
+      if constexpr (N > 5)
+        result += (1 - 2 * (c % 2)) * rhs[0][c] * determinant_laplace(submatrix(rhs, 0, c));
+      else
+        result += (1 - 2 * (c % 2)) * rhs[0][c] * determinant(submatrix(rhs, 0, c));
+    }
     return result;
   }
 
+  // generic determinant method, used for N > 4. floating point types go through lu_decompose,
+  // other types keep the exact cofactor expansion
+  template<int N, typename T>
+  constexpr T determinant(const Mat<N, N, T>& rhs)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      LU<N, T> lu{};
+      lu_decompose(rhs, lu);
+      return determinant(lu);
+    }
+    else
+      return determinant_laplace(rhs);
+  }
+
+  // generic inverse. N > 4 floating point matrices go through lu_decompose, which reports
+  // singularity from the pivots instead of comparing the determinant with zero
   template<int N, typename T>
-  inline Mat<N, N, T> inverse(const Mat<N, N, T>& rhs)
+  constexpr Mat<N, N, T> inverse(const Mat<N, N, T>& rhs)
   {
-    T det = determinant(rhs);
-    // if (approx_equal(det, T(0.0f)))
+    if constexpr (N > 4 && std::is_floating_point_v<T>)
+    {
+      LU<N, T> lu{};
+      lu_decompose(rhs, lu);
+      return inverse(lu);
+    }
+    else
+    {
+      T det = determinant(rhs);
+      // if (approx_equal(det, T(0.0f)))
+      if (det == 0)
+        return Mat<N, N, T>::zero;
+
+      return (adjoint(rhs) / det);
+    }
+  }
+
+  // inverse of an affine matrix (bottom row 0 0 0 1): the 3x3 linear block is inverted through
+  // cross products of its rows, and the translation is mapped back through it
+  template<typename T>
+  constexpr Mat<4, 4, T> inverse_affine(const Mat<4, 4, T>& rhs)
+  {
+    const Vec<3, T> r0(rhs[0][0], rhs[0][1], rhs[0][2]);
+    const Vec<3, T> r1(rhs[1][0], rhs[1][1], rhs[1][2]);
+    const Vec<3, T> r2(rhs[2][0], rhs[2][1], rhs[2][2]);
+    const Vec<3, T> t(rhs[0][3], rhs[1][3], rhs[2][3]);
+
+    // columns of the adjugate
+    const Vec<3, T> c0 = cross(r1, r2);
+    const Vec<3, T> c1 = cross(r2, r0);
+    const Vec<3, T> c2 = cross(r0, r1);
+    const T det = dot(r0, c0);
     if (det == 0)
-      return Mat<N, N, T>::zero;
+      return Mat<4, 4, T>::zero;
+
+    const T inv_det = 1 / det;
+    Mat<4, 4, T> result{};
+    for (int c = 0; c < 3; c++)
+    {
+      result[c][0] = c0[c] * inv_det;
+      result[c][1] = c1[c] * inv_det;
+      result[c][2] = c2[c] * inv_det;
+    }
+    for (int r = 0; r < 3; r++)
+      result[r][3] = -(result[r][0] * t.x + result[r][1] * t.y + result[r][2] * t.z);
+    result[3][0] = 0;
+    result[3][1] = 0;
+    result[3][2] = 0;
+    result[3][3] = 1;
+    return result;
+  }
 
-    return (adjoint(rhs) / determinant(rhs));
+  // inverse of a rigid transform (orthonormal rotation block plus translation): the rotation
+  // block is transposed. the caller guarantees the matrix has no scale or shear
+  template<typename T>
+  constexpr Mat<4, 4, T> inverse_rigid(const Mat<4, 4, T>& rhs)
+  {
+    Mat<4, 4, T> result{};
+    for (int r = 0; r < 3; r++)
+    {
+      result[r][0] = rhs[0][r];
+      result[r][1] = rhs[1][r];
+      result[r][2] = rhs[2][r];
+      result[r][3] = -(rhs[0][r] * rhs[0][3] + rhs[1][r] * rhs[1][3] + rhs[2][r] * rhs[2][3]);
+    }
+    result[3][0] = 0;
+    result[3][1] = 0;
+    result[3][2] = 0;
+    result[3][3] = 1;
+    return result;
+  }
+
+  // closed-form adjugate from the same 2x2 minors as determinant. affine matrices take inverse_affine
+  template<typename T>
+  constexpr Mat<4, 4, T> inverse(const Mat<4, 4, T>& rhs)
+  {
+    if (check_affine(rhs))
+      return inverse_affine(rhs);
+
+    const T s0 = rhs[0][0] * rhs[1][1] - rhs[1][0] * rhs[0][1];
+    const T s1 = rhs[0][0] * rhs[1][2] - rhs[1][0] * rhs[0][2];
+    const T s2 = rhs[0][0] * rhs[1][3] - rhs[1][0] * rhs[0][3];
+    const T s3 = rhs[0][1] * rhs[1][2] - rhs[1][1] * rhs[0][2];
+    const T s4 = rhs[0][1] * rhs[1][3] - rhs[1][1] * rhs[0][3];
+    const T s5 = rhs[0][2] * rhs[1][3] - rhs[1][2] * rhs[0][3];
+
+    const T c5 = rhs[2][2] * rhs[3][3] - rhs[3][2] * rhs[2][3];
+    const T c4 = rhs[2][1] * rhs[3][3] - rhs[3][1] * rhs[2][3];
+    const T c3 = rhs[2][1] * rhs[3][2] - rhs[3][1] * rhs[2][2];
+    const T c2 = rhs[2][0] * rhs[3][3] - rhs[3][0] * rhs[2][3];
+    const T c1 = rhs[2][0] * rhs[3][2] - rhs[3][0] * rhs[2][2];
+    const T c0 = rhs[2][0] * rhs[3][1] - rhs[3][0] * rhs[2][1];
+
+    const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (det == 0)
+      return Mat<4, 4, T>::zero;
+
+    const T inv_det = 1 / det;
+    Mat<4, 4, T> result{};
+    result[0][0] = ( rhs[1][1] * c5 - rhs[1][2] * c4 + rhs[1][3] * c3) * inv_det;
+    result[0][1] = (-rhs[0][1] * c5 + rhs[0][2] * c4 - rhs[0][3] * c3) * inv_det;
+    result[0][2] = ( rhs[3][1] * s5 - rhs[3][2] * s4 + rhs[3][3] * s3) * inv_det;
+    result[0][3] = (-rhs[2][1] * s5 + rhs[2][2] * s4 - rhs[2][3] * s3) * inv_det;
+    result[1][0] = (-rhs[1][0] * c5 + rhs[1][2] * c2 - rhs[1][3] * c1) * inv_det;
+    result[1][1] = ( rhs[0][0] * c5 - rhs[0][2] * c2 + rhs[0][3] * c1) * inv_det;
+    result[1][2] = (-rhs[3][0] * s5 + rhs[3][2] * s2 - rhs[3][3] * s1) * inv_det;
+    result[1][3] = ( rhs[2][0] * s5 - rhs[2][2] * s2 + rhs[2][3] * s1) * inv_det;
+    result[2][0] = ( rhs[1][0] * c4 - rhs[1][1] * c2 + rhs[1][3] * c0) * inv_det;
+    result[2][1] = (-rhs[0][0] * c4 + rhs[0][1] * c2 - rhs[0][3] * c0) * inv_det;
+    result[2][2] = ( rhs[3][0] * s4 - rhs[3][1] * s2 + rhs[3][3] * s0) * inv_det;
+    result[2][3] = (-rhs[2][0] * s4 + rhs[2][1] * s2 - rhs[2][3] * s0) * inv_det;
+    result[3][0] = (-rhs[1][0] * c3 + rhs[1][1] * c1 - rhs[1][2] * c0) * inv_det;
+    result[3][1] = ( rhs[0][0] * c3 - rhs[0][1] * c1 + rhs[0][2] * c0) * inv_det;
+    result[3][2] = (-rhs[3][0] * s3 + rhs[3][1] * s1 - rhs[3][2] * s0) * inv_det;
+    result[3][3] = ( rhs[2][0] * s3 - rhs[2][1] * s1 + rhs[2][2] * s0) * inv_det;
+    return result;
   }
 
   template<typename T>
-  inline Mat<3, 3, T> scale(const Vec<2, T>& scaling)
+  constexpr Mat<3, 3, T> scale(const Vec<2, T>& scaling)
   {
-    Mat<3, 3, T> result;
+    Mat<3, 3, T> result = Mat<3, 3, T>::identity;
     for (int i = 0; i < 2; i++)
       result[i][i] *= scaling[i];
     return result;
   }
 
   template<typename T>
-  inline void scale(Mat<3, 3, T>& result, const Vec<2, T>& scaling)
+  constexpr void scale(Mat<3, 3, T>& result, const Vec<2, T>& scaling)
   {
     for (int i = 0; i < 2; i++)
       result[i][i] *= scaling[i];
   }
 
   template<typename T>
-  inline Mat<4, 4, T> scale(const Vec<3, T>& scaling)
+  constexpr Mat<4, 4, T> scale(const Vec<3, T>& scaling)
   {
-    Mat<4, 4, T> result;
+    Mat<4, 4, T> result = Mat<4, 4, T>::identity;
     for (int i = 0; i < 3; i++)
       result[i][i] *= scaling[i];
     return result;
   }
 
   template<typename T>
-  inline void scale(Mat<4, 4, T>& result, const Vec<3, T>& scaling)
+  constexpr void scale(Mat<4, 4, T>& result, const Vec<3, T>& scaling)
   {
     for (int i = 0; i < 3; i++)
       result[i][i] *= scaling[i];
@@ -904,7 +1189,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Mat<4, 4, T> translate(Vec<3, T> distance)
+  constexpr Mat<4, 4, T> translate(Vec<3, T> distance)
   {
     return Mat<4, 4, T>({
       {1, 0, 0, distance.x},
@@ -915,7 +1200,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline void translate(Mat<4, 4, T>& result, Vec<3, T> distance)
+  constexpr void translate(Mat<4, 4, T>& result, Vec<3, T> distance)
   {
     result *= translate(distance);
   }
@@ -938,7 +1223,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Mat<4, 4, T> orthographic(T left, T right, T top, T bottom, T near, T far)
+  constexpr Mat<4, 4, T> orthographic(T left, T right, T top, T bottom, T near, T far)
   {
     return Mat<4, 4, T>({
       {2 / (right - left), 0,                  0,                                -(right + left) / (right - left)},
@@ -949,7 +1234,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Mat<4, 4, T> orthographic(T width, T height, T near, T far)
+  constexpr Mat<4, 4, T> orthographic(T width, T height, T near, T far)
   {
     return Mat<4, 4, T>({
       {2 / width,    0,          0,                 0                           },
@@ -960,7 +1245,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Mat<4, 4, T> perspective(T left, T right, T top, T bottom, T near, T far)
+  constexpr Mat<4, 4, T> perspective(T left, T right, T top, T bottom, T near, T far)
   {
     return Mat<4, 4, T>({
       {2 * near / (right - left), 0,                         (right + left) / (right - left),   0                             },
@@ -983,16 +1268,293 @@ namespace ndv
   }
 
   template<typename T>
-  inline bool check_affine(const Mat<3, 3, T>& rhs)
+  constexpr bool check_affine(const Mat<3, 3, T>& rhs)
   {
     return (rhs[2][0] == 0 && rhs[2][1] == 0 && rhs[2][2] == 1);
   }
 
   template<typename T>
-  inline bool check_affine(const Mat<4, 4, T>& rhs)
+  constexpr bool check_affine(const Mat<4, 4, T>& rhs)
   {
     return (rhs[3][0] == 0 && rhs[3][1] == 0 && rhs[3][2] == 0 && rhs[3][3] == 1);
   }
 
+#pragma endregion
+#pragma region "Affine Methods"
+  // the affine matrix with its implicit bottom row written out
+  template<typename T>
+  constexpr Mat<4, 4, T> to_mat4(const Mat<3, 4, T>& rhs)
+  {
+    Mat<4, 4, T> result{};
+    result[0] = rhs[0];
+    result[1] = rhs[1];
+    result[2] = rhs[2];
+    result[3] = Vec<4, T>(0, 0, 0, 1);
+    return result;
+  }
+
+  // top three rows of an affine Mat4, the caller guarantees check_affine(rhs)
+  template<typename T>
+  constexpr Mat<3, 4, T> to_affine(const Mat<4, 4, T>& rhs)
+  {
+    assert(check_affine(rhs));
+    Mat<3, 4, T> result{};
+    result[0] = rhs[0];
+    result[1] = rhs[1];
+    result[2] = rhs[2];
+    return result;
+  }
+
+  // product of the two affine transforms as 4x4 matrices. the implicit rows contribute only the
+  // translation of lhs, so each element takes 3 multiplies
+  template<typename T>
+  constexpr Mat<3, 4, T> operator*(const Mat<3, 4, T>& lhs, const Mat<3, 4, T>& rhs)
+  {
+    Mat<3, 4, T> result{};
+    for (int r = 0; r < 3; r++)
+    {
+      for (int c = 0; c < 4; c++)
+        result[r][c] = lhs[r][0] * rhs[0][c] + lhs[r][1] * rhs[1][c] + lhs[r][2] * rhs[2][c];
+      result[r][3] += lhs[r][3];
+    }
+    return result;
+  }
+
+  template<typename T>
+  constexpr Vec<3, T> transform_point(const Mat<3, 4, T>& lhs, const Vec<3, T>& rhs)
+  {
+    return Vec<3, T>(
+      lhs[0][0] * rhs.x + lhs[0][1] * rhs.y + lhs[0][2] * rhs.z + lhs[0][3],
+      lhs[1][0] * rhs.x + lhs[1][1] * rhs.y + lhs[1][2] * rhs.z + lhs[1][3],
+      lhs[2][0] * rhs.x + lhs[2][1] * rhs.y + lhs[2][2] * rhs.z + lhs[2][3]);
+  }
+
+  // the linear block only, translation does not apply to directions
+  template<typename T>
+  constexpr Vec<3, T> transform_direction(const Mat<3, 4, T>& lhs, const Vec<3, T>& rhs)
+  {
+    return Vec<3, T>(
+      lhs[0][0] * rhs.x + lhs[0][1] * rhs.y + lhs[0][2] * rhs.z,
+      lhs[1][0] * rhs.x + lhs[1][1] * rhs.y + lhs[1][2] * rhs.z,
+      lhs[2][0] * rhs.x + lhs[2][1] * rhs.y + lhs[2][2] * rhs.z);
+  }
+
+  // same method as inverse_affine, without the bottom row to fill in or test for
+  template<typename T>
+  constexpr Mat<3, 4, T> inverse(const Mat<3, 4, T>& rhs)
+  {
+    const Vec<3, T> r0(rhs[0][0], rhs[0][1], rhs[0][2]);
+    const Vec<3, T> r1(rhs[1][0], rhs[1][1], rhs[1][2]);
+    const Vec<3, T> r2(rhs[2][0], rhs[2][1], rhs[2][2]);
+    const Vec<3, T> t(rhs[0][3], rhs[1][3], rhs[2][3]);
+
+    // columns of the adjugate
+    const Vec<3, T> c0 = cross(r1, r2);
+    const Vec<3, T> c1 = cross(r2, r0);
+    const Vec<3, T> c2 = cross(r0, r1);
+    const T det = dot(r0, c0);
+    if (det == 0)
+      return Mat<3, 4, T>::zero;
+
+    const T inv_det = 1 / det;
+    Mat<3, 4, T> result{};
+    for (int r = 0; r < 3; r++)
+    {
+      const T x = c0[r] * inv_det, y = c1[r] * inv_det, z = c2[r] * inv_det;
+      result[r] = Vec<4, T>(x, y, z, -(x * t.x + y * t.y + z * t.z));
+    }
+    return result;
+  }
+
+  // the caller guarantees the linear block is a rotation, which is then transposed
+  template<typename T>
+  constexpr Mat<3, 4, T> inverse_rigid(const Mat<3, 4, T>& rhs)
+  {
+    Mat<3, 4, T> result{};
+    for (int r = 0; r < 3; r++)
+      result[r] = Vec<4, T>(rhs[0][r], rhs[1][r], rhs[2][r], -(rhs[0][r] * rhs[0][3] + rhs[1][r] * rhs[1][3] + rhs[2][r] * rhs[2][3]));
+    return result;
+  }
+
+#pragma endregion
+#if defined(NDV_SIMD_SSE)
+#pragma region "Mat SIMD Methods"
+  template<>
+  constexpr Mat<4, 4, float> operator*(const Mat<4, 4, float>& lhs, const Mat<4, 4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      Mat<4, 4, float> result{};
+      for (int r = 0; r < 4; r++)
+        for (int c = 0; c < 4; c++)
+          result[r][c] = lhs[r][0] * rhs[0][c] + lhs[r][1] * rhs[1][c] + lhs[r][2] * rhs[2][c] + lhs[r][3] * rhs[3][c];
+      return result;
+    }
+
+    const __m128 b0 = rhs.row[0].simd;
+    const __m128 b1 = rhs.row[1].simd;
+    const __m128 b2 = rhs.row[2].simd;
+    const __m128 b3 = rhs.row[3].simd;
+
+    Mat<4, 4, float> result{};
+    for (int r = 0; r < 4; r++)
+      result.row[r].simd = simd::row_mul(lhs.row[r].simd, b0, b1, b2, b3);
+    return result;
+  }
+
+  // rhs rows are loaded before any row is written, so this is safe when rhs aliases *this
+  template<>
+  constexpr Mat<4, 4, float>& Mat<4, 4, float>::operator*=(const Mat<4, 4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return (*this = *this * rhs);
+
+    const __m128 b0 = rhs.row[0].simd;
+    const __m128 b1 = rhs.row[1].simd;
+    const __m128 b2 = rhs.row[2].simd;
+    const __m128 b3 = rhs.row[3].simd;
+    for (int r = 0; r < 4; r++)
+      row[r].simd = simd::row_mul(row[r].simd, b0, b1, b2, b3);
+    return *this;
+  }
+
+  template<>
+  constexpr Vec<4, float> operator*(const Mat<4, 4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(dot(lhs[0], rhs), dot(lhs[1], rhs), dot(lhs[2], rhs), dot(lhs[3], rhs));
+
+    __m128 p0 = _mm_mul_ps(lhs.row[0].simd, rhs.simd);
+    __m128 p1 = _mm_mul_ps(lhs.row[1].simd, rhs.simd);
+    __m128 p2 = _mm_mul_ps(lhs.row[2].simd, rhs.simd);
+    __m128 p3 = _mm_mul_ps(lhs.row[3].simd, rhs.simd);
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    return Vec<4, float>(_mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+  }
+
+  // block form: with M = [A B; C D] split into 2x2 blocks, each held in one register,
+  // det(M) = |A||D| + |B||C| - tr((A#B)(D#C)) where # is the 2x2 adjugate
+  template<>
+  constexpr float determinant(const Mat<4, 4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return determinant_laplace(rhs);
+
+    const __m128 r0 = rhs.row[0].simd, r1 = rhs.row[1].simd, r2 = rhs.row[2].simd, r3 = rhs.row[3].simd;
+    const __m128 A = _mm_movelh_ps(r0, r1);
+    const __m128 B = _mm_movehl_ps(r1, r0);
+    const __m128 C = _mm_movelh_ps(r2, r3);
+    const __m128 D = _mm_movehl_ps(r3, r2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 det_sub = _mm_sub_ps(
+      _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+      _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 A_B = simd::mat2_adj_mul(A, B);
+    const __m128 D_C = simd::mat2_adj_mul(D, C);
+    const __m128 tr = simd::hsum(_mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0))));
+
+    const float* d = reinterpret_cast<const float*>(&det_sub);
+    return (d[0] * d[3] + d[1] * d[2] - _mm_cvtss_f32(tr));
+  }
+
+  template<>
+  constexpr Mat<4, 4, float> inverse(const Mat<4, 4, float>& rhs)
+  {
+    if (check_affine(rhs))
+      return inverse_affine(rhs);
+
+    if (detail::is_constant_evaluated())
+    {
+      const float det = determinant_laplace(rhs);
+      return (det == 0) ? Mat<4, 4, float>::zero : adjoint(rhs) / det;
+    }
+
+    const __m128 r0 = rhs.row[0].simd, r1 = rhs.row[1].simd, r2 = rhs.row[2].simd, r3 = rhs.row[3].simd;
+    const __m128 A = _mm_movelh_ps(r0, r1);
+    const __m128 B = _mm_movehl_ps(r1, r0);
+    const __m128 C = _mm_movelh_ps(r2, r3);
+    const __m128 D = _mm_movehl_ps(r3, r2);
+
+    const __m128 det_sub = _mm_sub_ps(
+      _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+      _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 det_A = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 det_B = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 det_C = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 det_D = _mm_shuffle_ps(det_sub, det_sub, _MM_SHUFFLE(3, 3, 3, 3));
+
+    const __m128 D_C = simd::mat2_adj_mul(D, C);
+    const __m128 A_B = simd::mat2_adj_mul(A, B);
+
+    // adjugates of the blocks of the inverse [X Y; Z W]
+    __m128 X_ = _mm_sub_ps(_mm_mul_ps(det_D, A), simd::mat2_mul(B, D_C));
+    __m128 W_ = _mm_sub_ps(_mm_mul_ps(det_A, D), simd::mat2_mul(C, A_B));
+    __m128 Y_ = _mm_sub_ps(_mm_mul_ps(det_B, C), simd::mat2_mul_adj(D, A_B));
+    __m128 Z_ = _mm_sub_ps(_mm_mul_ps(det_C, B), simd::mat2_mul_adj(A, D_C));
+
+    const __m128 tr = simd::hsum(_mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0))));
+    const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_A, det_D), _mm_mul_ps(det_B, det_C)), tr);
+    if (_mm_cvtss_f32(det) == 0)
+      return Mat<4, 4, float>::zero;
+
+    // (1/|M|, -1/|M|, -1/|M|, 1/|M|) applies the adjugate signs
+    const __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    X_ = _mm_mul_ps(X_, inv_det);
+    Y_ = _mm_mul_ps(Y_, inv_det);
+    Z_ = _mm_mul_ps(Z_, inv_det);
+    W_ = _mm_mul_ps(W_, inv_det);
+
+    // the shuffles undo the block adjugates and reassemble rows
+    Mat<4, 4, float> result{};
+    result.row[0].simd = _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(1, 3, 1, 3));
+    result.row[1].simd = _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(0, 2, 0, 2));
+    result.row[2].simd = _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(1, 3, 1, 3));
+    result.row[3].simd = _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(0, 2, 0, 2));
+    return result;
+  }
+
+  // rows are computed as in Mat4 * Mat4, with the implicit rhs row 0 0 0 1 reduced to adding the
+  // lhs translation lane
+  template<>
+  constexpr Mat<3, 4, float> operator*(const Mat<3, 4, float>& lhs, const Mat<3, 4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      Mat<3, 4, float> result{};
+      for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 4; c++)
+          result[r][c] = lhs[r][0] * rhs[0][c] + lhs[r][1] * rhs[1][c] + lhs[r][2] * rhs[2][c] + (c == 3 ? lhs[r][3] : 0.0f);
+      return result;
+    }
+
+    const __m128 b0 = rhs.row[0].simd;
+    const __m128 b1 = rhs.row[1].simd;
+    const __m128 b2 = rhs.row[2].simd;
+    const __m128 w_mask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    Mat<3, 4, float> result{};
+    for (int r = 0; r < 3; r++)
+    {
+      const __m128 a = lhs.row[r].simd;
+      __m128 v = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0), _mm_and_ps(a, w_mask));
+      v = simd::madd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1, v);
+      result.row[r].simd = simd::madd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2, v);
+    }
+    return result;
+  }
+
+#pragma endregion
+#endif
+#pragma region "Layout Checks"
+  // rows are stored back to back with no padding, so a Mat has the layout of T[N][M]
+  static_assert(std::is_trivially_copyable_v<Mat3> && std::is_standard_layout_v<Mat3>);
+  static_assert(std::is_trivially_copyable_v<Mat4> && std::is_standard_layout_v<Mat4>);
+  static_assert(std::is_trivially_copyable_v<Mat4d> && std::is_standard_layout_v<Mat4d>);
+  static_assert(sizeof(Mat2) == 4 * sizeof(float) && sizeof(Mat3) == 9 * sizeof(float) && sizeof(Mat4) == 16 * sizeof(float));
+  static_assert(sizeof(Mat4d) == 16 * sizeof(double));
+  static_assert(std::is_trivially_copyable_v<Affine3> && std::is_standard_layout_v<Affine3>);
+  static_assert(sizeof(Affine3) == 12 * sizeof(float) && sizeof(Affine3d) == 12 * sizeof(double));
+
 #pragma endregion
 }
\ No newline at end of file
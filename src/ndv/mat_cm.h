@@ -0,0 +1,285 @@
+#pragma once
+
+#include <ndv/execution.h>
+#include <ndv/mat.h>
+#include <ndv/simd.h>
+#include <ndv/span.h>
+#include <ndv/vec.h>
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "MatCM Definitions"
+  // Column-major NxM matrix, the layout OpenGL and Vulkan shaders read, so arrays of it upload
+  // without a transpose. The columns are stored as the rows of the row-major transpose, and every
+  // operation maps onto the row-major one through (A B)^T = B^T A^T and inv(A)^T = inv(A^T):
+  // products, determinant and inverse run the Mat code, SIMD included, with nothing transposed.
+  // The builders (translate, rotate, perspective, look_at, ...) stay row-major, col_major
+  // converts their result once.
+  template<int N, int M, typename T>
+  struct MatCM
+  {
+    // cols[c] is column c
+    Mat<M, N, T> cols;
+
+    static const MatCM identity;
+    static const MatCM zero;
+
+    MatCM() = default;
+    constexpr explicit MatCM(const Mat<N, M, T>& rhs) : cols(transpose(rhs)) {}
+
+    // column i, as Mat::operator[] returns row i
+    constexpr const Vec<N, T>& operator[](int i) const { return cols[i]; }
+    constexpr Vec<N, T>& operator[](int i) { return cols[i]; }
+    // element at row r, column c
+    constexpr const T& operator()(int r, int c) const { return cols[c][r]; }
+    constexpr T& operator()(int r, int c) { return cols[c][r]; }
+
+    constexpr MatCM& operator+=(const MatCM& rhs);
+    constexpr MatCM& operator-=(const MatCM& rhs);
+    constexpr MatCM& operator*=(const MatCM& rhs);
+    constexpr MatCM& operator*=(T rhs);
+    constexpr MatCM& operator/=(T rhs);
+  };
+
+  using Mat2CM = MatCM<2, 2, float>;
+  using Mat3CM = MatCM<3, 3, float>;
+  using Mat4CM = MatCM<4, 4, float>;
+  using Mat4dCM = MatCM<4, 4, double>;
+
+#pragma endregion
+#pragma region "MatCM Methods"
+  template<int N, int M, typename T> inline constexpr MatCM<N, M, T> MatCM<N, M, T>::identity = MatCM<N, M, T>(Mat<N, M, T>::identity);
+  template<int N, int M, typename T> inline constexpr MatCM<N, M, T> MatCM<N, M, T>::zero = MatCM<N, M, T>(Mat<N, M, T>::zero);
+
+  // from storage, the row-major transpose
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> from_cols(const Mat<M, N, T>& cols)
+  {
+    MatCM<N, M, T> result{};
+    result.cols = cols;
+    return result;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> col_major(const Mat<N, M, T>& rhs)
+  {
+    return MatCM<N, M, T>(rhs);
+  }
+
+  template<int N, int M, typename T>
+  constexpr Mat<N, M, T> row_major(const MatCM<N, M, T>& rhs)
+  {
+    return transpose(rhs.cols);
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T>& MatCM<N, M, T>::operator+=(const MatCM<N, M, T>& rhs)
+  {
+    cols += rhs.cols;
+    return *this;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T>& MatCM<N, M, T>::operator-=(const MatCM<N, M, T>& rhs)
+  {
+    cols -= rhs.cols;
+    return *this;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T>& MatCM<N, M, T>::operator*=(const MatCM<N, M, T>& rhs)
+  {
+    cols = rhs.cols * cols;
+    return *this;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T>& MatCM<N, M, T>::operator*=(T rhs)
+  {
+    cols *= rhs;
+    return *this;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T>& MatCM<N, M, T>::operator/=(T rhs)
+  {
+    cols /= rhs;
+    return *this;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> operator-(const MatCM<N, M, T>& rhs)
+  {
+    return from_cols<N, M>(-rhs.cols);
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> operator+(const MatCM<N, M, T>& lhs, const MatCM<N, M, T>& rhs)
+  {
+    return from_cols<N, M>(lhs.cols + rhs.cols);
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> operator-(const MatCM<N, M, T>& lhs, const MatCM<N, M, T>& rhs)
+  {
+    return from_cols<N, M>(lhs.cols - rhs.cols);
+  }
+
+  // (lhs rhs)^T = rhs^T lhs^T
+  template<int N, int M, int O, typename T>
+  constexpr MatCM<N, O, T> operator*(const MatCM<N, M, T>& lhs, const MatCM<M, O, T>& rhs)
+  {
+    return from_cols<N, O>(rhs.cols * lhs.cols);
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> operator*(const MatCM<N, M, T>& lhs, T rhs)
+  {
+    return from_cols<N, M>(lhs.cols * rhs);
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> operator*(T lhs, const MatCM<N, M, T>& rhs)
+  {
+    return from_cols<N, M>(lhs * rhs.cols);
+  }
+
+  // the columns scaled by the elements of rhs and summed
+  template<int N, int M, typename T>
+  constexpr Vec<N, T> operator*(const MatCM<N, M, T>& lhs, const Vec<M, T>& rhs)
+  {
+    Vec<N, T> result{};
+    for (int r = 0; r < N; r++)
+      result[r] = lhs.cols[0][r] * rhs[0];
+    for (int c = 1; c < M; c++)
+      for (int r = 0; r < N; r++)
+        result[r] += lhs.cols[c][r] * rhs[c];
+    return result;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<N, M, T> operator/(const MatCM<N, M, T>& lhs, T rhs)
+  {
+    return from_cols<N, M>(lhs.cols / rhs);
+  }
+
+  template<int N, int M, typename T>
+  constexpr bool operator==(const MatCM<N, M, T>& lhs, const MatCM<N, M, T>& rhs)
+  {
+    return lhs.cols == rhs.cols;
+  }
+
+  template<int N, int M, typename T>
+  constexpr bool operator!=(const MatCM<N, M, T>& lhs, const MatCM<N, M, T>& rhs)
+  {
+    return lhs.cols != rhs.cols;
+  }
+
+  template<int N, int M, typename T>
+  constexpr MatCM<M, N, T> transpose(const MatCM<N, M, T>& rhs)
+  {
+    return from_cols<M, N>(transpose(rhs.cols));
+  }
+
+  template<int N, typename T>
+  constexpr T determinant(const MatCM<N, N, T>& rhs)
+  {
+    return determinant(rhs.cols);
+  }
+
+  template<int N, typename T>
+  constexpr MatCM<N, N, T> inverse(const MatCM<N, N, T>& rhs)
+  {
+    return from_cols<N, N>(inverse(rhs.cols));
+  }
+
+  // the bottom row 0 0 0 1 is the last element of each column
+  template<typename T>
+  constexpr bool check_affine(const MatCM<4, 4, T>& rhs)
+  {
+    return (rhs.cols[0][3] == 0 && rhs.cols[1][3] == 0 && rhs.cols[2][3] == 0 && rhs.cols[3][3] == 1);
+  }
+
+#pragma endregion
+#if defined(NDV_SIMD_SSE)
+#pragma region "MatCM SIMD Methods"
+  // one broadcast multiply-add per column, where the row-major product needs a transpose
+  template<>
+  constexpr Vec<4, float> operator*(const MatCM<4, 4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return lhs.cols[0] * rhs.x + lhs.cols[1] * rhs.y + lhs.cols[2] * rhs.z + lhs.cols[3] * rhs.w;
+
+    return Vec<4, float>(simd::row_mul(rhs.simd, lhs.cols.row[0].simd, lhs.cols.row[1].simd, lhs.cols.row[2].simd, lhs.cols.row[3].simd));
+  }
+
+#pragma endregion
+#endif
+#pragma region "Batch Layout Methods"
+  // Bulk conversion between the layouts, e.g. a row-major world matrix array into an upload
+  // buffer, in one streaming pass. A 4x4 transpose is its own inverse, so both directions are the
+  // same kernel, and each matrix is read before it is written, so out may alias in.
+  namespace detail
+  {
+    inline void transpose4(const Mat<4, 4, float>* in, Mat<4, 4, float>* out, std::size_t n)
+    {
+#if defined(NDV_SIMD_SSE)
+      for (std::size_t i = 0; i < n; i++)
+      {
+        __m128 r0 = in[i].row[0].simd, r1 = in[i].row[1].simd, r2 = in[i].row[2].simd, r3 = in[i].row[3].simd;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        out[i].row[0].simd = r0;
+        out[i].row[1].simd = r1;
+        out[i].row[2].simd = r2;
+        out[i].row[3].simd = r3;
+      }
+#else
+      for (std::size_t i = 0; i < n; i++)
+        out[i] = transpose(in[i]);
+#endif
+    }
+  }
+
+  inline void col_major(span<const Mat<4, 4, float>> in, span<MatCM<4, 4, float>> out)
+  {
+    assert(in.size() == out.size());
+    detail::transpose4(in.data(), &out.data()->cols, in.size());
+  }
+
+  inline void row_major(span<const MatCM<4, 4, float>> in, span<Mat<4, 4, float>> out)
+  {
+    assert(in.size() == out.size());
+    detail::transpose4(&in.data()->cols, out.data(), in.size());
+  }
+
+  template<typename Policy, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void col_major(const Policy& policy, span<const Mat<4, 4, float>> in, span<MatCM<4, 4, float>> out)
+  {
+    assert(in.size() == out.size());
+    detail::for_each_block(policy, in.size(), detail::block_size(2 * sizeof(Mat<4, 4, float>)), [&](std::size_t b, std::size_t e) {
+      detail::transpose4(in.data() + b, &out.data()[b].cols, e - b);
+    });
+  }
+
+  template<typename Policy, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void row_major(const Policy& policy, span<const MatCM<4, 4, float>> in, span<Mat<4, 4, float>> out)
+  {
+    assert(in.size() == out.size());
+    detail::for_each_block(policy, in.size(), detail::block_size(2 * sizeof(Mat<4, 4, float>)), [&](std::size_t b, std::size_t e) {
+      detail::transpose4(&in.data()[b].cols, out.data() + b, e - b);
+    });
+  }
+
+#pragma endregion
+#pragma region "Layout Checks"
+  // the columns are stored back to back with no padding, a MatCM has the layout of T[M][N]
+  static_assert(std::is_trivially_copyable_v<Mat4CM> && std::is_standard_layout_v<Mat4CM>);
+  static_assert(sizeof(Mat3CM) == 9 * sizeof(float) && sizeof(Mat4CM) == 16 * sizeof(float));
+  static_assert(sizeof(Mat4dCM) == 16 * sizeof(double));
+
+#pragma endregion
+}
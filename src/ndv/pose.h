@@ -0,0 +1,313 @@
+#pragma once
+
+#include <ndv/quat.h>
+#include <ndv/simd.h>
+#include <ndv/span.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "Pose Definitions"
+  // Pose blending over arrays of bone rotations. The kernels have no data-dependent branches: the
+  // shortest-path sign is applied with copysign (a sign-bit mask in the SIMD path), and slerp uses
+  // a polynomial form of its weights instead of acos and sin, so NDV_USE_SIMD blends four bones
+  // per step.
+
+  enum class PoseBlend
+  {
+    nlerp,
+    slerp
+  };
+
+  // one input of blend_layers. override layers are averaged by weight, additive layers hold
+  // rotations relative to the reference pose and are applied on top, scaled by weight
+  struct PoseLayer
+  {
+    span<const Quat> pose;
+    float weight;
+    bool additive = false;
+  };
+
+  namespace detail
+  {
+    // sin((1 - t) theta) / sin(theta) and sin(t theta) / sin(theta) as truncated products in
+    // cos(theta) - 1 (Eberly, "A Fast and Accurate Algorithm for Computing SLERP"). valid for
+    // cos(theta) >= 0, which the shortest-path sign guarantees, with an error below 2e-5
+    constexpr float slerp_mu = 1.85298109240830f;
+    constexpr float slerp_u[8] = {
+      1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9),
+      1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), slerp_mu / (8 * 17)
+    };
+    constexpr float slerp_v[8] = {
+      1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+      5.0f / 11, 6.0f / 13, 7.0f / 15, slerp_mu * 8 / 17
+    };
+  }
+
+#pragma endregion
+#pragma region "Pose Kernel Methods"
+  namespace detail
+  {
+    inline void slerp_weights(float cos_theta, float t, float& wa, float& wb)
+    {
+      const float xm1 = cos_theta - 1;
+      const float s = 1 - t;
+      const float ss = s * s, tt = t * t;
+      float ra = 1, rb = 1;
+      for (int i = 7; i >= 0; i--)
+      {
+        ra = 1 + (slerp_u[i] * ss - slerp_v[i]) * xm1 * ra;
+        rb = 1 + (slerp_u[i] * tt - slerp_v[i]) * xm1 * rb;
+      }
+      wa = s * ra;
+      wb = t * rb;
+    }
+
+    template<PoseBlend mode>
+    inline Quat blend_quat(const Quat& a, const Quat& b, float t)
+    {
+      const float d = dot(a, b);
+      const float sign = std::copysign(1.0f, d);
+      if constexpr (mode == PoseBlend::slerp)
+      {
+        float wa, wb;
+        slerp_weights(std::abs(d), t, wa, wb);
+        return (a * wa) + (b * (sign * wb));
+      }
+      else
+      {
+        const Quat r = (a * (1 - t)) + (b * (sign * t));
+        return r / std::sqrt(length_squared(r));
+      }
+    }
+
+    // nlerp from the identity towards q
+    inline Quat scale_rotation(const Quat& q, float weight)
+    {
+      const Quat r = Quat(1 - weight, 0, 0, 0) + (q * std::copysign(weight, q.w));
+      return r / std::sqrt(length_squared(r));
+    }
+
+    // blend_layers for one bone
+    inline Quat blend_bone(span<const PoseLayer> layers, std::size_t i)
+    {
+      Quat acc(0);
+      Quat ref(0);
+      bool first = true;
+      for (const PoseLayer& layer : layers)
+      {
+        if (layer.additive)
+          continue;
+        const Quat q = layer.pose[i];
+        if (first)
+          ref = q;
+        first = false;
+        acc += q * std::copysign(layer.weight, dot(ref, q));
+      }
+
+      Quat result = first ? Quat::identity : acc / std::sqrt(length_squared(acc));
+      for (const PoseLayer& layer : layers)
+        if (layer.additive)
+          result = result * scale_rotation(layer.pose[i], layer.weight);
+      return result;
+    }
+
+#if defined(NDV_SIMD_SSE)
+    // four quaternions, one register per component
+    struct QuatX4
+    {
+      __m128 w, x, y, z;
+
+      void load(const Quat* p) { simd::load_transpose4(&p->w, w, x, y, z); }
+      void store(Quat* p) const { simd::store_transpose4(&p->w, w, x, y, z); }
+    };
+
+    inline __m128 dot(const QuatX4& a, const QuatX4& b)
+    {
+      return simd::madd(a.w, b.w, simd::madd(a.x, b.x, simd::madd(a.y, b.y, _mm_mul_ps(a.z, b.z))));
+    }
+
+    // a * wa + b * wb
+    inline QuatX4 combine(const QuatX4& a, __m128 wa, const QuatX4& b, __m128 wb)
+    {
+      return {
+        simd::madd(a.w, wa, _mm_mul_ps(b.w, wb)),
+        simd::madd(a.x, wa, _mm_mul_ps(b.x, wb)),
+        simd::madd(a.y, wa, _mm_mul_ps(b.y, wb)),
+        simd::madd(a.z, wa, _mm_mul_ps(b.z, wb))
+      };
+    }
+
+    inline QuatX4 normalize(const QuatX4& q)
+    {
+      const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(dot(q, q)));
+      return {_mm_mul_ps(q.w, inv), _mm_mul_ps(q.x, inv), _mm_mul_ps(q.y, inv), _mm_mul_ps(q.z, inv)};
+    }
+
+    // Hamilton product
+    inline QuatX4 mul(const QuatX4& a, const QuatX4& b)
+    {
+      return {
+        _mm_sub_ps(_mm_mul_ps(a.w, b.w), simd::madd(a.x, b.x, simd::madd(a.y, b.y, _mm_mul_ps(a.z, b.z)))),
+        _mm_sub_ps(simd::madd(a.w, b.x, simd::madd(a.x, b.w, _mm_mul_ps(a.y, b.z))), _mm_mul_ps(a.z, b.y)),
+        _mm_sub_ps(simd::madd(a.w, b.y, simd::madd(a.y, b.w, _mm_mul_ps(a.z, b.x))), _mm_mul_ps(a.x, b.z)),
+        _mm_sub_ps(simd::madd(a.w, b.z, simd::madd(a.x, b.y, _mm_mul_ps(a.z, b.w))), _mm_mul_ps(a.y, b.x))
+      };
+    }
+
+    inline void slerp_weights(__m128 cos_theta, __m128 t, __m128& wa, __m128& wb)
+    {
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 xm1 = _mm_sub_ps(cos_theta, one);
+      const __m128 s = _mm_sub_ps(one, t);
+      const __m128 ss = _mm_mul_ps(s, s), tt = _mm_mul_ps(t, t);
+      __m128 ra = one, rb = one;
+      for (int i = 7; i >= 0; i--)
+      {
+        const __m128 u = _mm_set1_ps(slerp_u[i]), v = _mm_set1_ps(slerp_v[i]);
+        ra = simd::madd(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, ss), v), xm1), ra, one);
+        rb = simd::madd(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, tt), v), xm1), rb, one);
+      }
+      wa = _mm_mul_ps(s, ra);
+      wb = _mm_mul_ps(t, rb);
+    }
+
+    template<PoseBlend mode>
+    inline void blend_quat4(const Quat* a, const Quat* b, __m128 t, Quat* out)
+    {
+      QuatX4 qa, qb;
+      qa.load(a);
+      qb.load(b);
+      const __m128 d = dot(qa, qb);
+      const __m128 sign = _mm_and_ps(d, _mm_set1_ps(-0.0f));
+
+      __m128 wa, wb;
+      if constexpr (mode == PoseBlend::slerp)
+        slerp_weights(_mm_xor_ps(d, sign), t, wa, wb);
+      else
+      {
+        wa = _mm_sub_ps(_mm_set1_ps(1.0f), t);
+        wb = t;
+      }
+
+      const QuatX4 r = combine(qa, wa, qb, _mm_xor_ps(wb, sign));
+      if constexpr (mode == PoseBlend::slerp)
+        r.store(out);
+      else
+        normalize(r).store(out);
+    }
+
+    inline void blend_bone4(span<const PoseLayer> layers, std::size_t i, Quat* out)
+    {
+      const __m128 zero = _mm_setzero_ps();
+      const __m128 sign_mask = _mm_set1_ps(-0.0f);
+      QuatX4 acc{zero, zero, zero, zero};
+      QuatX4 ref{};
+      bool first = true;
+      for (const PoseLayer& layer : layers)
+      {
+        if (layer.additive)
+          continue;
+        QuatX4 q;
+        q.load(layer.pose.data() + i);
+        if (first)
+          ref = q;
+        first = false;
+        const __m128 w = _mm_xor_ps(_mm_set1_ps(layer.weight), _mm_and_ps(dot(ref, q), sign_mask));
+        acc = combine(q, w, acc, _mm_set1_ps(1.0f));
+      }
+
+      const __m128 one = _mm_set1_ps(1.0f);
+      QuatX4 result = first ? QuatX4{one, zero, zero, zero} : normalize(acc);
+      for (const PoseLayer& layer : layers)
+      {
+        if (!layer.additive)
+          continue;
+        QuatX4 q;
+        q.load(layer.pose.data() + i);
+        const __m128 w = _mm_xor_ps(_mm_set1_ps(layer.weight), _mm_and_ps(q.w, sign_mask));
+        QuatX4 scaled = combine(q, w, QuatX4{one, zero, zero, zero}, _mm_set1_ps(1.0f - layer.weight));
+        result = mul(result, normalize(scaled));
+      }
+      result.store(out);
+    }
+#endif
+
+    template<PoseBlend mode, typename Weight>
+    inline void blend_poses(span<const Quat> a, span<const Quat> b, Weight weight, span<Quat> out)
+    {
+      assert(a.size() == b.size() && out.size() == a.size());
+      const std::size_t n = a.size();
+      std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+      for (; i + 4 <= n; i += 4)
+      {
+        if constexpr (std::is_same_v<Weight, float>)
+          blend_quat4<mode>(a.data() + i, b.data() + i, _mm_set1_ps(weight), out.data() + i);
+        else
+          blend_quat4<mode>(a.data() + i, b.data() + i, _mm_loadu_ps(weight.data() + i), out.data() + i);
+      }
+#endif
+      for (; i < n; i++)
+      {
+        if constexpr (std::is_same_v<Weight, float>)
+          out[i] = blend_quat<mode>(a[i], b[i], weight);
+        else
+          out[i] = blend_quat<mode>(a[i], b[i], weight[i]);
+      }
+    }
+  }
+
+#pragma endregion
+#pragma region "Pose Methods"
+  // out[i] = nlerp or slerp from a[i] to b[i] by t, along the shorter path. out may be a or b
+  inline void blend_poses(span<const Quat> a, span<const Quat> b, float t, span<Quat> out, PoseBlend mode = PoseBlend::nlerp)
+  {
+    if (mode == PoseBlend::slerp)
+      detail::blend_poses<PoseBlend::slerp>(a, b, t, out);
+    else
+      detail::blend_poses<PoseBlend::nlerp>(a, b, t, out);
+  }
+
+  // per-bone blend weights, e.g. a bone mask
+  inline void blend_poses(span<const Quat> a, span<const Quat> b, span<const float> weights, span<Quat> out, PoseBlend mode = PoseBlend::nlerp)
+  {
+    assert(weights.size() == a.size());
+    if (mode == PoseBlend::slerp)
+      detail::blend_poses<PoseBlend::slerp>(a, b, weights, out);
+    else
+      detail::blend_poses<PoseBlend::nlerp>(a, b, weights, out);
+  }
+
+  // Blends any number of layers in one pass over the bones. The override layers are averaged by
+  // weight (normalized, with signs aligned to the first override layer), then the additive layers
+  // are applied in order. Without override layers the base is the identity. The override weights
+  // must not sum to zero, and out may be the pose of any layer.
+  inline void blend_layers(span<const PoseLayer> layers, span<Quat> out)
+  {
+    const std::size_t n = out.size();
+    for ([[maybe_unused]] const PoseLayer& layer : layers)
+      assert(layer.pose.size() == n);
+
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    for (; i + 4 <= n; i += 4)
+      detail::blend_bone4(layers, i, out.data() + i);
+#endif
+    for (; i < n; i++)
+      out[i] = detail::blend_bone(layers, i);
+  }
+
+  // out[i] = base[i] * additive[i] scaled by weight (nlerp from the identity). out may be base
+  inline void add_pose(span<const Quat> base, span<const Quat> additive, float weight, span<Quat> out)
+  {
+    const PoseLayer layers[] = {{base, 1.0f, false}, {additive, weight, true}};
+    blend_layers(layers, out);
+  }
+
+#pragma endregion
+}
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <ndv/mat.h>
+#include <ndv/span.h>
 #include <ndv/vec.h>
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace ndv
 {
@@ -21,21 +26,77 @@ namespace ndv
     static Quat axis_angle(const Vec<3, float>& axis, float angle);
     static const Quat identity;
 
-    Quat() : w(1), x(0), y(0), z(0) {}
-    Quat(float arg) : w(arg), x(arg), y(arg), z(arg) {}
-    Quat(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {}
-    Quat(float scalar, const Vec<3, float>& real) : w(scalar), real(real) {}
-    explicit Quat(const Vec<3, float>& real) : w(0) , real(real) {}
-
-    const float& operator[](int i) const;
-    float& operator[](int i);
-
-    Quat& operator=(const Quat& rhs);
-    Quat& operator+=(const Quat& rhs);
-    Quat& operator-=(const Quat& rhs);
-    Quat& operator*=(const Quat& rhs);
-    Quat& operator*=(float rhs);
-    Quat& operator/=(float rhs);
+    // x, y, z are the initialized members, so constant expressions never read through real
+    constexpr Quat() : w(1), x(0), y(0), z(0) {}
+    constexpr Quat(float arg) : w(arg), x(arg), y(arg), z(arg) {}
+    constexpr Quat(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {}
+    constexpr Quat(float scalar, const Vec<3, float>& real) : w(scalar), x(real.x), y(real.y), z(real.z) {}
+    constexpr explicit Quat(const Vec<3, float>& real) : w(0), x(real.x), y(real.y), z(real.z) {}
+
+    constexpr const float& operator[](int i) const;
+    constexpr float& operator[](int i);
+
+    constexpr Quat& operator+=(const Quat& rhs);
+    constexpr Quat& operator-=(const Quat& rhs);
+    constexpr Quat& operator*=(const Quat& rhs);
+    constexpr Quat& operator*=(float rhs);
+    constexpr Quat& operator/=(float rhs);
+  };
+
+  // slerp between fixed endpoints. the angle and shortest-path sign are resolved once, so a sample
+  // costs two sin calls and no inverse trig, and sample() steps through evenly spaced t with one
+  // quaternion product per rotation
+  struct SlerpInterpolator
+  {
+    Quat from;
+    Quat to; // negated when needed to take the shorter path
+    float theta; // half the rotation angle between the endpoints
+    float inv_sin_theta;
+    bool linear; // endpoints (nearly) coincide, normalized lerp is used
+
+    // steps of sample() between exact re-evaluations, bounds the accumulated rounding error
+    static constexpr std::size_t restart_interval = 32;
+
+    SlerpInterpolator() = default;
+    SlerpInterpolator(const Quat& from, const Quat& to);
+
+    Quat operator()(float t) const;
+    void sample(span<Quat> out, float t0 = 0, float t1 = 1) const;
+  };
+
+  // Smallest-three packed rotation for animation tracks. The largest component is dropped and
+  // rebuilt from the unit length, the sign of the quaternion is flipped to make it positive (q and
+  // -q are the same rotation), and the other three lie in [-1/sqrt(2), 1/sqrt(2)] and are stored
+  // in order with Bits bits each, followed by the 2-bit index of the dropped component.
+  template<int Bits>
+  struct PackedQuat
+  {
+    static_assert(Bits == 10 || Bits == 15 || Bits == 20, "smallest-three packing uses 10, 15 or 20 bits per component");
+    using word_type = std::conditional_t<Bits == 10, std::uint32_t, std::conditional_t<Bits == 15, std::uint16_t, std::uint64_t>>;
+
+    // three 16-bit words keep the 48-bit form at 2-byte alignment
+    word_type words[Bits == 15 ? 3 : 1];
+
+    PackedQuat() = default;
+    explicit PackedQuat(const Quat& q);
+
+    std::uint64_t bits() const;
+    Quat unpack() const;
+  };
+
+  using PackedQuat32 = PackedQuat<10>;
+  using PackedQuat48 = PackedQuat<15>;
+  using PackedQuat64 = PackedQuat<20>;
+
+  // all four components as snorm16, renormalized when unpacked
+  struct PackedQuatS16
+  {
+    std::int16_t w, x, y, z;
+
+    PackedQuatS16() = default;
+    explicit PackedQuatS16(const Quat& q);
+
+    Quat unpack() const;
   };
 
 #pragma endregion
@@ -47,9 +108,9 @@ namespace ndv
     return Quat(scalar, real);
   }
 
-  const Quat Quat::identity = Quat(1, 0, 0, 0);
+  inline constexpr Quat Quat::identity = Quat(1, 0, 0, 0);
 
-  inline const float& Quat::operator[](int i) const
+  constexpr const float& Quat::operator[](int i) const
   {
     assert(i >= 0 && i < 4);
     switch (i)
@@ -66,7 +127,7 @@ namespace ndv
     }
   }
 
-  inline float& Quat::operator[](int i)
+  constexpr float& Quat::operator[](int i)
   {
     assert(i >= 0 && i < 4);
     switch (i)
@@ -83,16 +144,7 @@ namespace ndv
     }
   }
 
-  inline Quat& Quat::operator=(const Quat& rhs)
-  {
-    w = rhs.w;
-    x = rhs.x;
-    y = rhs.y;
-    z = rhs.z;
-    return *this;
-  }
-
-  inline Quat& Quat::operator+=(const Quat& rhs)
+  constexpr Quat& Quat::operator+=(const Quat& rhs)
   {
     w += rhs.w;
     x += rhs.x;
@@ -101,7 +153,7 @@ namespace ndv
     return *this;
   }
 
-  inline Quat& Quat::operator-=(const Quat& rhs)
+  constexpr Quat& Quat::operator-=(const Quat& rhs)
   {
     w -= rhs.w;
     x -= rhs.x;
@@ -110,16 +162,20 @@ namespace ndv
     return *this;
   }
 
-  inline Quat& Quat::operator*=(const Quat& rhs)
+  constexpr Quat& Quat::operator*=(const Quat& rhs)
   {
-    w = w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z;
-    x = w * rhs.x - x * rhs.w - y * rhs.z - z * rhs.y;
-    y = w * rhs.y - x * rhs.z - y * rhs.w - z * rhs.x;
-    z = w * rhs.z - x * rhs.y - y * rhs.x - z * rhs.w;
+    const float rw = w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z;
+    const float rx = w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y;
+    const float ry = w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x;
+    const float rz = w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w;
+    w = rw;
+    x = rx;
+    y = ry;
+    z = rz;
     return *this;
   }
 
-  inline Quat& Quat::operator*=(float rhs)
+  constexpr Quat& Quat::operator*=(float rhs)
   {
     w *= rhs;
     x *= rhs;
@@ -128,7 +184,7 @@ namespace ndv
     return *this;
   }
 
-  inline Quat& Quat::operator/=(float rhs)
+  constexpr Quat& Quat::operator/=(float rhs)
   {
     w /= rhs;
     x /= rhs;
@@ -137,69 +193,70 @@ namespace ndv
     return *this;
   }
 
-  inline Quat operator+(const Quat& rhs)
+  constexpr Quat operator+(const Quat& rhs)
   {
     return rhs;
   }
 
-  inline Quat operator-(const Quat& rhs)
+  constexpr Quat operator-(const Quat& rhs)
   {
     return Quat(-rhs.w, -rhs.x, -rhs.y, -rhs.z);
   }
 
-  inline Quat operator+(const Quat& lhs, const Quat& rhs)
+  constexpr Quat operator+(const Quat& lhs, const Quat& rhs)
   {
     return Quat(lhs.w + rhs.w, lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
   }
 
-  inline Quat operator-(const Quat& lhs, const Quat& rhs)
+  constexpr Quat operator-(const Quat& lhs, const Quat& rhs)
   {
-    return Quat(lhs.w * rhs.w, lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z);
+    return Quat(lhs.w - rhs.w, lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
   }
 
-  inline Quat operator*(const Quat& lhs, const Quat& rhs)
+  // Hamilton product, lhs * rhs applies rhs first when rotating
+  constexpr Quat operator*(const Quat& lhs, const Quat& rhs)
   {
     return Quat(
       lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
-      lhs.w * rhs.x - lhs.x * rhs.w - lhs.y * rhs.z - lhs.z * rhs.y,
-      lhs.w * rhs.y - lhs.x * rhs.z - lhs.y * rhs.w - lhs.z * rhs.x,
-      lhs.w * rhs.z - lhs.x * rhs.y - lhs.y * rhs.x - lhs.z * rhs.w
+      lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+      lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+      lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w
     );
   }
 
-  inline Quat operator*(const Quat& lhs, float rhs)
+  constexpr Quat operator*(const Quat& lhs, float rhs)
   {
     return Quat(lhs.w * rhs, lhs.x * rhs, lhs.y * rhs, lhs.z * rhs);
   }
 
-  inline Quat operator*(float lhs, const Quat& rhs)
+  constexpr Quat operator*(float lhs, const Quat& rhs)
   {
     return Quat(lhs * rhs.w, lhs * rhs.x, lhs * rhs.y, lhs * rhs.z);
   }
 
-  inline Quat operator/(const Quat& lhs, float rhs)
+  constexpr Quat operator/(const Quat& lhs, float rhs)
   {
     return Quat(lhs.w / rhs, lhs.x / rhs, lhs.y / rhs, lhs.z / rhs);
   }
 
-  inline Quat operator/(float lhs, const Quat& rhs)
+  constexpr Quat operator/(float lhs, const Quat& rhs)
   {
     return Quat(lhs / rhs.w, lhs / rhs.x, lhs / rhs.y, lhs / rhs.z);
   }
 
-  inline bool operator==(const Quat& lhs, const Quat& rhs)
+  constexpr bool operator==(const Quat& lhs, const Quat& rhs)
   {
     return (lhs.w == rhs.w && lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z);
   }
 
-  inline bool operator!=(const Quat& lhs, const Quat& rhs)
+  constexpr bool operator!=(const Quat& lhs, const Quat& rhs)
   {
     return (lhs.w != rhs.w || lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z);
   }
 
 #pragma endregion
 #pragma region "Utility Methods"
-  inline float length_squared(const Quat& rhs)
+  constexpr float length_squared(const Quat& rhs)
   {
     return rhs.w * rhs.w + rhs.x * rhs.x + rhs.y * rhs.y + rhs.z * rhs.z;
   }
@@ -220,12 +277,12 @@ namespace ndv
     return normalize(Quat(rhs.w + 1, rhs.x, rhs.y, rhs.z));
   }
 
-  inline float dot(const Quat& lhs, const Quat& rhs)
+  constexpr float dot(const Quat& lhs, const Quat& rhs)
   {
     return (lhs.w * rhs.w + lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z);
   }
 
-  inline Quat cross(const Quat& lhs, const Quat& rhs)
+  constexpr Quat cross(const Quat& lhs, const Quat& rhs)
   {
 		return Quat(
 			lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
@@ -235,20 +292,102 @@ namespace ndv
     );
   }
 
-  inline Quat conjugate(const Quat& rhs)
+  constexpr Quat conjugate(const Quat& rhs)
   {
     return Quat(rhs.w, -rhs.x, -rhs.y, -rhs.z);
   }
 
-  inline Quat inverse(const Quat& rhs)
+  constexpr Quat inverse(const Quat& rhs)
   {
-    return (conjugate(rhs) / length(rhs));
+    return (conjugate(rhs) / length_squared(rhs));
   }
 
   // NOTE: quaternion must be normalized
-  inline Vec<3, float> rotate(const Vec<3, float>& v, const Quat& by)
+  // expanded by * Quat(v) * conjugate(by): v + w t + by.xyz x t with t = 2 by.xyz x v
+  constexpr Vec<3, float> rotate(const Vec<3, float>& v, const Quat& by)
   {
-    return (by * Quat(v) * conjugate(by)).real;
+    const float tx = 2 * (by.y * v.z - by.z * v.y);
+    const float ty = 2 * (by.z * v.x - by.x * v.z);
+    const float tz = 2 * (by.x * v.y - by.y * v.x);
+    return Vec<3, float>(
+      v.x + by.w * tx + (by.y * tz - by.z * ty),
+      v.y + by.w * ty + (by.z * tx - by.x * tz),
+      v.z + by.w * tz + (by.x * ty - by.y * tx));
+  }
+
+  // NOTE: quaternion must be normalized
+  // rotation matrix acting on column vectors, to_mat3(q) * v == rotate(v, q)
+  constexpr Mat<3, 3, float> to_mat3(const Quat& q)
+  {
+    const float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+    // rows are assigned whole, the initializer list constructors loop element by element
+    Mat<3, 3, float> result{};
+    result.row[0] = Vec<3, float>(1 - (yy + zz), xy - wz, xz + wy);
+    result.row[1] = Vec<3, float>(xy + wz, 1 - (xx + zz), yz - wx);
+    result.row[2] = Vec<3, float>(xz - wy, yz + wx, 1 - (xx + yy));
+    return result;
+  }
+
+  // NOTE: quaternion must be normalized
+  constexpr Mat<4, 4, float> to_mat4(const Quat& q)
+  {
+    const float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+    Mat<4, 4, float> result{};
+    result.row[0] = Vec<4, float>(1 - (yy + zz), xy - wz, xz + wy, 0);
+    result.row[1] = Vec<4, float>(xy + wz, 1 - (xx + zz), yz - wx, 0);
+    result.row[2] = Vec<4, float>(xz - wy, yz + wx, 1 - (xx + yy), 0);
+    result.row[3] = Vec<4, float>(0, 0, 0, 1);
+    return result;
+  }
+
+  // Shepperd's method: the square root is taken of the largest of 4w^2, 4x^2, 4y^2, 4z^2 (read off
+  // the trace and diagonal), which keeps the division well conditioned. the matrix must be a
+  // rotation, any scale has to be removed first
+  inline Quat from_matrix(const Mat<3, 3, float>& m)
+  {
+    const float m00 = m.row[0].x, m01 = m.row[0].y, m02 = m.row[0].z;
+    const float m10 = m.row[1].x, m11 = m.row[1].y, m12 = m.row[1].z;
+    const float m20 = m.row[2].x, m21 = m.row[2].y, m22 = m.row[2].z;
+    const float trace = m00 + m11 + m22;
+
+    if (trace >= m00 && trace >= m11 && trace >= m22)
+    {
+      const float r = std::sqrt(1 + trace);
+      const float s = 0.5f / r;
+      return Quat(0.5f * r, (m21 - m12) * s, (m02 - m20) * s, (m10 - m01) * s);
+    }
+    if (m00 >= m11 && m00 >= m22)
+    {
+      const float r = std::sqrt(1 + m00 - m11 - m22);
+      const float s = 0.5f / r;
+      return Quat((m21 - m12) * s, 0.5f * r, (m01 + m10) * s, (m02 + m20) * s);
+    }
+    if (m11 >= m22)
+    {
+      const float r = std::sqrt(1 - m00 + m11 - m22);
+      const float s = 0.5f / r;
+      return Quat((m02 - m20) * s, (m01 + m10) * s, 0.5f * r, (m12 + m21) * s);
+    }
+    const float r = std::sqrt(1 - m00 - m11 + m22);
+    const float s = 0.5f / r;
+    return Quat((m10 - m01) * s, (m02 + m20) * s, (m12 + m21) * s, 0.5f * r);
+  }
+
+  // upper 3x3 block, translation and projection are ignored
+  inline Quat from_matrix(const Mat<4, 4, float>& m)
+  {
+    Mat<3, 3, float> r{};
+    for (int i = 0; i < 3; i++)
+      r.row[i] = Vec<3, float>(m.row[i].x, m.row[i].y, m.row[i].z);
+    return from_matrix(r);
   }
 
   // NOTE: quaternion must be normalized
@@ -317,5 +456,272 @@ namespace ndv
 
   // }
 
+#pragma endregion
+#pragma region "SlerpInterpolator Methods"
+  // NOTE: quaternions must be normalized
+  inline SlerpInterpolator::SlerpInterpolator(const Quat& from, const Quat& to) : from(from), to(to)
+  {
+    float cos_theta = dot(from, to);
+    // shortest path
+    if (cos_theta < 0.0f)
+    {
+      this->to = -to;
+      cos_theta = -cos_theta;
+    }
+
+    theta = std::acos(std::min(cos_theta, 1.0f));
+    const float sin_theta = std::sin(theta);
+    linear = (sin_theta < 1e-4f);
+    inv_sin_theta = linear ? 0.0f : 1.0f / sin_theta;
+  }
+
+  inline Quat SlerpInterpolator::operator()(float t) const
+  {
+    if (linear)
+      return normalize(from * (1.0f - t) + to * t);
+
+    const float a = std::sin((1.0f - t) * theta) * inv_sin_theta;
+    const float b = std::sin(t * theta) * inv_sin_theta;
+    return (a * from) + (b * to);
+  }
+
+  // out[k] = (*this)(t0 + k * (t1 - t0) / (out.size() - 1)). slerp(t + h) = slerp(t) * d with the
+  // fixed increment d = (conjugate(from) * to)^h, and every restart_interval steps the sequence is
+  // re-seeded from an exact evaluation so the drift does not grow with out.size()
+  inline void SlerpInterpolator::sample(span<Quat> out, float t0, float t1) const
+  {
+    const std::size_t n = out.size();
+    if (n == 0)
+      return;
+    if (n == 1 || linear)
+    {
+      const float h = (n > 1) ? (t1 - t0) / float(n - 1) : 0.0f;
+      for (std::size_t k = 0; k < n; k++)
+        out[k] = (*this)(t0 + h * float(k));
+      return;
+    }
+
+    const float h = (t1 - t0) / float(n - 1);
+    // conjugate(from) * to = (cos theta, sin theta * axis), its power h is (cos h theta, sin h theta * axis)
+    const Quat rel = conjugate(from) * to;
+    const Quat d(std::cos(h * theta), Vec<3, float>(rel.x, rel.y, rel.z) * (std::sin(h * theta) * inv_sin_theta));
+
+    Quat q;
+    for (std::size_t k = 0; k < n; k++)
+    {
+      q = (k % restart_interval == 0) ? (*this)(t0 + h * float(k)) : q * d;
+      out[k] = q;
+    }
+  }
+
+#pragma endregion
+#pragma region "Packed Quat Methods"
+  namespace detail
+  {
+    constexpr float sqrt_half = 0.707106781186547524f;
+
+    // decodes the three stored components and the dropped index of one smallest-three word
+    template<int Bits>
+    inline Quat unpack_smallest_three(std::uint64_t bits)
+    {
+      constexpr std::uint64_t mask = (std::uint64_t(1) << Bits) - 1;
+      constexpr float scale = 2.0f * sqrt_half / float(mask);
+      const int largest = int(bits >> (3 * Bits));
+
+      float c[3];
+      for (int k = 0; k < 3; k++)
+        c[k] = float((bits >> (k * Bits)) & mask) * scale - sqrt_half;
+
+      // positions of the stored components for each dropped index, a table keeps this branch-free
+      constexpr int kept[4][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+      float q[4];
+      for (int k = 0; k < 3; k++)
+        q[kept[largest][k]] = c[k];
+      q[largest] = std::sqrt(std::max(0.0f, 1.0f - (c[0] * c[0] + c[1] * c[1] + c[2] * c[2])));
+      return Quat(q[0], q[1], q[2], q[3]);
+    }
+
+#if defined(NDV_SIMD_SSE)
+    // fields of four smallest-three words, each shifted down and masked in its own 32-bit lane
+    template<int Bits>
+    inline void load_smallest_three4(const PackedQuat<Bits>* p, __m128i (&c)[3], __m128i& largest)
+    {
+      const __m128i mask = _mm_set1_epi32((1 << Bits) - 1);
+      if constexpr (Bits == 10)
+      {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        for (int k = 0; k < 3; k++)
+          c[k] = _mm_and_si128(_mm_srli_epi32(v, k * Bits), mask);
+        largest = _mm_srli_epi32(v, 3 * Bits);
+      }
+      else
+      {
+        // two words per register, the low halves of each 64-bit lane are gathered after shifting
+        const __m128i lo = _mm_set_epi64x(std::int64_t(p[1].bits()), std::int64_t(p[0].bits()));
+        const __m128i hi = _mm_set_epi64x(std::int64_t(p[3].bits()), std::int64_t(p[2].bits()));
+        const auto field = [&](int shift) {
+          return _mm_castps_si128(_mm_shuffle_ps(
+            _mm_castsi128_ps(_mm_srli_epi64(lo, shift)), _mm_castsi128_ps(_mm_srli_epi64(hi, shift)), _MM_SHUFFLE(2, 0, 2, 0)));
+        };
+        for (int k = 0; k < 3; k++)
+          c[k] = _mm_and_si128(field(k * Bits), mask);
+        largest = _mm_and_si128(field(3 * Bits), _mm_set1_epi32(3));
+      }
+    }
+
+    // four quaternions per iteration, the dropped component is put back in place with selects
+    template<int Bits>
+    inline void unpack4(const PackedQuat<Bits>* p, Quat* out)
+    {
+      constexpr float scale = 2.0f * sqrt_half / float((1 << Bits) - 1);
+      __m128i fields[3], largest;
+      load_smallest_three4(p, fields, largest);
+
+      __m128 c[3];
+      for (int k = 0; k < 3; k++)
+        c[k] = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(fields[k]), _mm_set1_ps(scale)), _mm_set1_ps(sqrt_half));
+      const __m128 sum = simd::madd(c[0], c[0], simd::madd(c[1], c[1], _mm_mul_ps(c[2], c[2])));
+      const __m128 d = _mm_sqrt_ps(_mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_set1_ps(1.0f), sum)));
+
+      const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(0)));
+      const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(1)));
+      const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(2)));
+      const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(3)));
+      const __m128 w = simd::select(is0, d, c[0]);
+      const __m128 x = simd::select(is0, c[0], simd::select(is1, d, c[1]));
+      const __m128 y = simd::select(is2, d, simd::select(is3, c[2], c[1]));
+      const __m128 z = simd::select(is3, d, c[2]);
+      simd::store_transpose4(&out->w, w, x, y, z);
+    }
+#endif
+
+    template<int Bits>
+    inline void pack(span<const Quat> in, span<PackedQuat<Bits>> out)
+    {
+      assert(in.size() == out.size());
+      for (std::size_t i = 0; i < in.size(); i++)
+        out[i] = PackedQuat<Bits>(in[i]);
+    }
+
+    template<int Bits>
+    inline void unpack(span<const PackedQuat<Bits>> in, span<Quat> out)
+    {
+      assert(in.size() == out.size());
+      std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+      for (; i + 4 <= in.size(); i += 4)
+        unpack4(in.data() + i, out.data() + i);
+#endif
+      for (; i < in.size(); i++)
+        out[i] = in[i].unpack();
+    }
+  }
+
+  // NOTE: quaternion must be normalized
+  template<int Bits>
+  inline PackedQuat<Bits>::PackedQuat(const Quat& q)
+  {
+    constexpr std::uint64_t mask = (std::uint64_t(1) << Bits) - 1;
+    int largest = 0;
+    for (int i = 1; i < 4; i++)
+    {
+      if (std::abs(q[i]) > std::abs(q[largest]))
+        largest = i;
+    }
+
+    // maps [-1/sqrt(2), 1/sqrt(2)] onto [0, mask], rounded to nearest
+    const float scale = (q[largest] < 0 ? -0.5f : 0.5f) / detail::sqrt_half * float(mask);
+    std::uint64_t bits = std::uint64_t(largest) << (3 * Bits);
+    for (int i = 0, k = 0; i < 4; i++)
+    {
+      if (i == largest)
+        continue;
+      const float u = std::clamp(q[i] * scale + 0.5f * float(mask) + 0.5f, 0.0f, float(mask));
+      bits |= std::uint64_t(u) << (k++ * Bits);
+    }
+
+    if constexpr (Bits == 15)
+    {
+      for (int i = 0; i < 3; i++)
+        words[i] = std::uint16_t(bits >> (16 * i));
+    }
+    else
+      words[0] = word_type(bits);
+  }
+
+  template<int Bits>
+  inline std::uint64_t PackedQuat<Bits>::bits() const
+  {
+    if constexpr (Bits == 15)
+      return std::uint64_t(words[0]) | (std::uint64_t(words[1]) << 16) | (std::uint64_t(words[2]) << 32);
+    else
+      return words[0];
+  }
+
+  template<int Bits>
+  inline Quat PackedQuat<Bits>::unpack() const
+  {
+    return detail::unpack_smallest_three<Bits>(bits());
+  }
+
+  inline PackedQuatS16::PackedQuatS16(const Quat& q)
+  {
+    const auto snorm = [](float v) { return std::int16_t(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f)); };
+    w = snorm(q.w);
+    x = snorm(q.x);
+    y = snorm(q.y);
+    z = snorm(q.z);
+  }
+
+  inline Quat PackedQuatS16::unpack() const
+  {
+    return normalize(Quat(float(w), float(x), float(y), float(z)));
+  }
+
+  // bulk conversion of rotation tracks, out[i] = PackedQuat(in[i])
+  inline void pack(span<const Quat> in, span<PackedQuat32> out) { detail::pack<10>(in, out); }
+  inline void pack(span<const Quat> in, span<PackedQuat48> out) { detail::pack<15>(in, out); }
+  inline void pack(span<const Quat> in, span<PackedQuat64> out) { detail::pack<20>(in, out); }
+
+  inline void pack(span<const Quat> in, span<PackedQuatS16> out)
+  {
+    assert(in.size() == out.size());
+    for (std::size_t i = 0; i < in.size(); i++)
+      out[i] = PackedQuatS16(in[i]);
+  }
+
+  // out[i] = in[i].unpack(), four quaternions at a time with SIMD
+  inline void unpack(span<const PackedQuat32> in, span<Quat> out) { detail::unpack<10>(in, out); }
+  inline void unpack(span<const PackedQuat48> in, span<Quat> out) { detail::unpack<15>(in, out); }
+  inline void unpack(span<const PackedQuat64> in, span<Quat> out) { detail::unpack<20>(in, out); }
+
+  inline void unpack(span<const PackedQuatS16> in, span<Quat> out)
+  {
+    assert(in.size() == out.size());
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    // sign-extends two quaternions per load and normalizes each with a broadcast dot product
+    for (; i + 2 <= in.size(); i += 2)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+      const __m128 a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+      const __m128 b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+      _mm_storeu_ps(&out[i].w, _mm_div_ps(a, _mm_sqrt_ps(simd::dot(a, a))));
+      _mm_storeu_ps(&out[i + 1].w, _mm_div_ps(b, _mm_sqrt_ps(simd::dot(b, b))));
+    }
+#endif
+    for (; i < in.size(); i++)
+      out[i] = in[i].unpack();
+  }
+
+#pragma endregion
+#pragma region "Layout Checks"
+  // stored as w, x, y, z
+  static_assert(std::is_trivially_copyable_v<Quat> && std::is_standard_layout_v<Quat>);
+  static_assert(sizeof(Quat) == 4 * sizeof(float));
+  static_assert(sizeof(PackedQuat32) == 4 && sizeof(PackedQuat48) == 6 && sizeof(PackedQuat64) == 8);
+  static_assert(sizeof(PackedQuatS16) == 8);
+  static_assert(std::is_trivially_copyable_v<PackedQuat48> && std::is_trivially_copyable_v<PackedQuatS16>);
+
 #pragma endregion
 }
\ No newline at end of file
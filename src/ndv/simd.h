@@ -0,0 +1,204 @@
+#pragma once
+
+// SIMD backend selection. The packed specializations are opt-in: define NDV_USE_SIMD
+// (or configure with -DNDV_USE_SIMD=ON) and the instruction sets enabled for the
+// compiler are used. Without it, or on targets without SSE2, the scalar templates are used.
+#if defined(NDV_USE_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define NDV_SIMD_SSE 1
+  #endif
+  #if defined(NDV_SIMD_SSE) && (defined(__SSE4_1__) || defined(__AVX__))
+    #define NDV_SIMD_SSE4_1 1
+  #endif
+  #if defined(NDV_SIMD_SSE) && defined(__AVX__)
+    #define NDV_SIMD_AVX 1
+  #endif
+  #if defined(NDV_SIMD_SSE) && defined(__FMA__)
+    #define NDV_SIMD_FMA 1
+  #endif
+  #if defined(NDV_SIMD_SSE) && defined(__F16C__)
+    #define NDV_SIMD_F16C 1
+  #endif
+#endif
+
+#if defined(NDV_SIMD_SSE)
+#include <immintrin.h>
+#endif
+
+namespace ndv::simd
+{
+#if defined(NDV_SIMD_SSE)
+  // horizontal sum, broadcast to all lanes
+  inline __m128 hsum(__m128 v)
+  {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm_add_ps(sums, shuf);
+  }
+
+  // dot product, broadcast to all lanes
+  inline __m128 dot(__m128 lhs, __m128 rhs)
+  {
+#if defined(NDV_SIMD_SSE4_1)
+    return _mm_dp_ps(lhs, rhs, 0xFF);
+#else
+    return hsum(_mm_mul_ps(lhs, rhs));
+#endif
+  }
+
+  // a * b + c
+  inline __m128 madd(__m128 a, __m128 b, __m128 c)
+  {
+#if defined(NDV_SIMD_FMA)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+  }
+
+  inline __m128 negate(__m128 v)
+  {
+    return _mm_xor_ps(v, _mm_set1_ps(-0.0f));
+  }
+
+  // mask ? a : b per lane, mask lanes are all ones or all zeros
+  inline __m128 select(__m128 mask, __m128 a, __m128 b)
+  {
+#if defined(NDV_SIMD_SSE4_1)
+    return _mm_blendv_ps(b, a, mask);
+#else
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#endif
+  }
+
+  // one row of a 4x4 product in row-broadcast form: a.x * b0 + a.y * b1 + a.z * b2 + a.w * b3
+  inline __m128 row_mul(__m128 a, __m128 b0, __m128 b1, __m128 b2, __m128 b3)
+  {
+    __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+    r = madd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), b1, r);
+    r = madd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), b2, r);
+    return madd(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b3, r);
+  }
+
+  // 2x2 matrices held row-major in one register: (m00, m01, m10, m11)
+
+  // a * b
+  inline __m128 mat2_mul(__m128 a, __m128 b)
+  {
+    return _mm_add_ps(
+      _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+  }
+
+  // adj(a) * b
+  inline __m128 mat2_adj_mul(__m128 a, __m128 b)
+  {
+    return _mm_sub_ps(
+      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+  }
+
+  // a * adj(b)
+  inline __m128 mat2_mul_adj(__m128 a, __m128 b)
+  {
+    return _mm_sub_ps(
+      _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+  }
+
+  // deinterleaves four packed xyz triples (12 floats) into x, y and z lanes
+  inline void load_xyz4(const float* p, __m128& x, __m128& y, __m128& z)
+  {
+    const __m128 a = _mm_loadu_ps(p);     // x0 y0 z0 x1
+    const __m128 b = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+    const __m128 c = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+    x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(
+      _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+      _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+      _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+  }
+
+  // inverse of load_xyz4
+  inline void store_xyz4(float* p, __m128 x, __m128 y, __m128 z)
+  {
+    const __m128 a = _mm_shuffle_ps(
+      _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+      _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+      _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 b = _mm_shuffle_ps(
+      _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+      _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+      _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 c = _mm_shuffle_ps(
+      _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+      _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+      _MM_SHUFFLE(2, 0, 2, 0));
+    _mm_storeu_ps(p, a);
+    _mm_storeu_ps(p + 4, b);
+    _mm_storeu_ps(p + 8, c);
+  }
+
+  // four packed 4-float records (e.g. Quats) transposed into one register per field
+  inline void load_transpose4(const float* p, __m128& a, __m128& b, __m128& c, __m128& d)
+  {
+    a = _mm_loadu_ps(p);
+    b = _mm_loadu_ps(p + 4);
+    c = _mm_loadu_ps(p + 8);
+    d = _mm_loadu_ps(p + 12);
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+  }
+
+  // inverse of load_transpose4
+  inline void store_transpose4(float* p, __m128 a, __m128 b, __m128 c, __m128 d)
+  {
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(p, a);
+    _mm_storeu_ps(p + 4, b);
+    _mm_storeu_ps(p + 8, c);
+    _mm_storeu_ps(p + 12, d);
+  }
+
+  // a unit quaternion broadcast for rotating four vectors held in x, y, z lanes, using
+  // v' = v + w t + q.xyz x t with t = 2 q.xyz x v
+  struct QuatLanes
+  {
+    __m128 qx, qy, qz, qw;
+
+    QuatLanes(float w, float x, float y, float z) : qx(_mm_set1_ps(x)), qy(_mm_set1_ps(y)), qz(_mm_set1_ps(z)), qw(_mm_set1_ps(w)) {}
+
+    void rotate(__m128& x, __m128& y, __m128& z) const
+    {
+      const __m128 two = _mm_set1_ps(2.0f);
+      const __m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)));
+      const __m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)));
+      const __m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)));
+      x = _mm_add_ps(madd(qw, tx, x), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+      y = _mm_add_ps(madd(qw, ty, y), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+      z = _mm_add_ps(madd(qw, tz, z), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+    }
+  };
+#endif
+
+#if defined(NDV_SIMD_AVX)
+  // horizontal sum of all four lanes
+  inline double hsum(__m256d v)
+  {
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+    return _mm_cvtsd_f64(s);
+  }
+
+  inline double dot(__m256d lhs, __m256d rhs)
+  {
+    return hsum(_mm256_mul_pd(lhs, rhs));
+  }
+
+  inline __m256d negate(__m256d v)
+  {
+    return _mm256_xor_pd(v, _mm256_set1_pd(-0.0));
+  }
+#endif
+}
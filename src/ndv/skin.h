@@ -0,0 +1,154 @@
+#pragma once
+
+#include <ndv/execution.h>
+#include <ndv/mat.h>
+#include <ndv/simd.h>
+#include <ndv/span.h>
+#include <ndv/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "Skinning Definitions"
+  namespace detail
+  {
+    // the input streams of skin_vertices
+    struct SkinStreams
+    {
+      span<const Vec<3, float>> positions;
+      span<const Vec<3, float>> normals;
+      span<const std::uint16_t> joint_indices;
+      span<const float> weights;
+      int influences;
+    };
+
+    // affine rows of the weighted sum of a vertex's joint matrices
+    inline void blend_joints(span<const Mat<4, 4, float>> palette, const std::uint16_t* joints, const float* weights, int influences, float (&m)[3][4])
+    {
+      for (int r = 0; r < 3; r++)
+        for (int c = 0; c < 4; c++)
+          m[r][c] = 0;
+      for (int k = 0; k < influences; k++)
+      {
+        const Mat<4, 4, float>& joint = palette[joints[k]];
+        for (int r = 0; r < 3; r++)
+          for (int c = 0; c < 4; c++)
+            m[r][c] += weights[k] * joint.row[r][c];
+      }
+    }
+
+    inline void skin_range(span<const Mat<4, 4, float>> palette, const SkinStreams& in, span<Vec<3, float>> out_positions, span<Vec<3, float>> out_normals, std::size_t begin, std::size_t end)
+    {
+      const int k = in.influences;
+      const bool normals = !in.normals.empty();
+      std::size_t i = begin;
+
+#if defined(NDV_SIMD_SSE)
+      // four vertices per step, one per lane: the rows of each influence's four joint matrices
+      // are transposed so every element of the blended 3x4 matrix is a register of four vertices
+      for (; i + 4 <= end; i += 4)
+      {
+        __m128 m[3][4];
+        for (int r = 0; r < 3; r++)
+          for (int c = 0; c < 4; c++)
+            m[r][c] = _mm_setzero_ps();
+
+        const std::uint16_t* joints = in.joint_indices.data() + i * k;
+        const float* weights = in.weights.data() + i * k;
+        for (int j = 0; j < k; j++)
+        {
+          const Mat<4, 4, float>& m0 = palette[joints[j]];
+          const Mat<4, 4, float>& m1 = palette[joints[k + j]];
+          const Mat<4, 4, float>& m2 = palette[joints[2 * k + j]];
+          const Mat<4, 4, float>& m3 = palette[joints[3 * k + j]];
+          const __m128 w = _mm_setr_ps(weights[j], weights[k + j], weights[2 * k + j], weights[3 * k + j]);
+          for (int r = 0; r < 3; r++)
+          {
+            __m128 c0 = _mm_loadu_ps(&m0.row[r].x), c1 = _mm_loadu_ps(&m1.row[r].x);
+            __m128 c2 = _mm_loadu_ps(&m2.row[r].x), c3 = _mm_loadu_ps(&m3.row[r].x);
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            m[r][0] = simd::madd(w, c0, m[r][0]);
+            m[r][1] = simd::madd(w, c1, m[r][1]);
+            m[r][2] = simd::madd(w, c2, m[r][2]);
+            m[r][3] = simd::madd(w, c3, m[r][3]);
+          }
+        }
+
+        __m128 x, y, z;
+        simd::load_xyz4(&in.positions[i].x, x, y, z);
+        simd::store_xyz4(&out_positions[i].x,
+          simd::madd(m[0][0], x, simd::madd(m[0][1], y, simd::madd(m[0][2], z, m[0][3]))),
+          simd::madd(m[1][0], x, simd::madd(m[1][1], y, simd::madd(m[1][2], z, m[1][3]))),
+          simd::madd(m[2][0], x, simd::madd(m[2][1], y, simd::madd(m[2][2], z, m[2][3]))));
+        if (normals)
+        {
+          simd::load_xyz4(&in.normals[i].x, x, y, z);
+          simd::store_xyz4(&out_normals[i].x,
+            simd::madd(m[0][0], x, simd::madd(m[0][1], y, _mm_mul_ps(m[0][2], z))),
+            simd::madd(m[1][0], x, simd::madd(m[1][1], y, _mm_mul_ps(m[1][2], z))),
+            simd::madd(m[2][0], x, simd::madd(m[2][1], y, _mm_mul_ps(m[2][2], z))));
+        }
+      }
+#endif
+
+      for (; i < end; i++)
+      {
+        float m[3][4];
+        blend_joints(palette, in.joint_indices.data() + i * k, in.weights.data() + i * k, k, m);
+        const Vec<3, float> p = in.positions[i];
+        out_positions[i] = Vec<3, float>(
+          m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.z + m[0][3],
+          m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.z + m[1][3],
+          m[2][0] * p.x + m[2][1] * p.y + m[2][2] * p.z + m[2][3]);
+        if (normals)
+        {
+          const Vec<3, float> n = in.normals[i];
+          out_normals[i] = Vec<3, float>(
+            m[0][0] * n.x + m[0][1] * n.y + m[0][2] * n.z,
+            m[1][0] * n.x + m[1][1] * n.y + m[1][2] * n.z,
+            m[2][0] * n.x + m[2][1] * n.y + m[2][2] * n.z);
+        }
+      }
+    }
+  }
+
+#pragma endregion
+#pragma region "Skinning Methods"
+  // Linear blend skinning. Each vertex has `influences` (1 to 8) joint index and weight pairs,
+  // stored vertex after vertex in joint_indices and weights, and the weights of a vertex should
+  // sum to one. The joint matrices are blended once per vertex (only their affine 3x4 part is
+  // read), and normals use the same blended matrix without being renormalized. normals may be
+  // empty, out_normals is then ignored.
+  //
+  // Under an execution policy (see execution.h) the vertices are skinned block by block.
+  template<typename Policy, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void skin_vertices(const Policy& policy, span<const Mat<4, 4, float>> palette, span<const Vec<3, float>> positions, span<const Vec<3, float>> normals,
+    span<const std::uint16_t> joint_indices, span<const float> weights, int influences,
+    span<Vec<3, float>> out_positions, span<Vec<3, float>> out_normals)
+  {
+    const std::size_t n = positions.size();
+    assert(influences >= 1 && influences <= 8);
+    assert(joint_indices.size() == n * influences && weights.size() == n * influences);
+    assert(out_positions.size() == n && (normals.empty() || (normals.size() == n && out_normals.size() == n)));
+    const detail::SkinStreams in{positions, normals, joint_indices, weights, influences};
+
+    const std::size_t bytes_per_vertex = 4 * sizeof(Vec<3, float>) + influences * (sizeof(std::uint16_t) + sizeof(float));
+    detail::for_each_block(policy, n, detail::block_size(bytes_per_vertex), [&](std::size_t begin, std::size_t end) {
+      detail::skin_range(palette, in, out_positions, out_normals, begin, end);
+    });
+  }
+
+  inline void skin_vertices(span<const Mat<4, 4, float>> palette, span<const Vec<3, float>> positions, span<const Vec<3, float>> normals,
+    span<const std::uint16_t> joint_indices, span<const float> weights, int influences,
+    span<Vec<3, float>> out_positions, span<Vec<3, float>> out_normals)
+  {
+    skin_vertices(seq, palette, positions, normals, joint_indices, weights, influences, out_positions, out_normals);
+  }
+
+#pragma endregion
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ndv
+{
+#pragma region "Span Definitions"
+  // std::type_identity from C++20. wrapping span parameters of function templates in it keeps T
+  // out of deduction, so containers still convert to the span at the call site
+  template<typename T>
+  struct type_identity { using type = T; };
+  template<typename T>
+  using type_identity_t = typename type_identity<T>::type;
+
+  // non-owning view over contiguous elements, a C++17 stand-in for std::span<T>
+  template<typename T>
+  class span
+  {
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    span() = default;
+    span(T* data, std::size_t size) : ptr(data), count(size) {}
+    span(T* first, T* last) : ptr(first), count(static_cast<std::size_t>(last - first)) {}
+
+    template<std::size_t S>
+    span(T (&arr)[S]) : ptr(arr), count(S) {}
+
+    // any contiguous container exposing data() and size(), e.g. std::vector or std::array
+    template<typename C, typename = std::enable_if_t<
+      !std::is_same_v<std::remove_cv_t<std::remove_reference_t<C>>, span> &&
+      std::is_convertible_v<decltype(std::declval<C&>().data()), T*>>>
+    span(C&& container) : ptr(container.data()), count(container.size()) {}
+
+    // span<T> -> span<const T>
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    span(const span<U>& rhs) : ptr(rhs.data()), count(rhs.size()) {}
+
+    T* data() const { return ptr; }
+    std::size_t size() const { return count; }
+    std::size_t size_bytes() const { return count * sizeof(T); }
+    bool empty() const { return count == 0; }
+
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + count; }
+
+    T& operator[](std::size_t i) const;
+
+    span first(std::size_t n) const;
+    span last(std::size_t n) const;
+    span subspan(std::size_t offset, std::size_t n) const;
+    span subspan(std::size_t offset) const;
+
+  private:
+    T* ptr = nullptr;
+    std::size_t count = 0;
+  };
+
+#pragma endregion
+#pragma region "Span Methods"
+  template<typename T>
+  inline T& span<T>::operator[](std::size_t i) const
+  {
+    assert(i < count);
+    return ptr[i];
+  }
+
+  template<typename T>
+  inline span<T> span<T>::first(std::size_t n) const
+  {
+    assert(n <= count);
+    return span<T>(ptr, n);
+  }
+
+  template<typename T>
+  inline span<T> span<T>::last(std::size_t n) const
+  {
+    assert(n <= count);
+    return span<T>(ptr + (count - n), n);
+  }
+
+  template<typename T>
+  inline span<T> span<T>::subspan(std::size_t offset, std::size_t n) const
+  {
+    assert(offset <= count && n <= count - offset);
+    return span<T>(ptr + offset, n);
+  }
+
+  template<typename T>
+  inline span<T> span<T>::subspan(std::size_t offset) const
+  {
+    assert(offset <= count);
+    return span<T>(ptr + offset, count - offset);
+  }
+
+#pragma endregion
+#pragma region "Byte View Methods"
+  // views over the object representation of trivially copyable elements, e.g. a std::vector<Mat4>
+  // handed to a GPU upload or serialization call without an intermediate copy
+  template<typename T>
+  inline span<const std::byte> as_bytes(span<T> s)
+  {
+    static_assert(std::is_trivially_copyable_v<std::remove_cv_t<T>>, "as_bytes requires a trivially copyable type");
+    return span<const std::byte>(reinterpret_cast<const std::byte*>(s.data()), s.size_bytes());
+  }
+
+  template<typename T, typename = std::enable_if_t<!std::is_const_v<T>>>
+  inline span<std::byte> as_writable_bytes(span<T> s)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "as_writable_bytes requires a trivially copyable type");
+    return span<std::byte>(reinterpret_cast<std::byte*>(s.data()), s.size_bytes());
+  }
+
+  // contiguous containers exposing data() and size()
+  template<typename C, typename T = std::remove_pointer_t<decltype(std::declval<const C&>().data())>>
+  inline span<const std::byte> as_bytes(const C& container)
+  {
+    return as_bytes(span<T>(container.data(), container.size()));
+  }
+
+  template<typename C, typename T = std::remove_pointer_t<decltype(std::declval<C&>().data())>>
+  inline span<std::byte> as_writable_bytes(C& container)
+  {
+    return as_writable_bytes(span<T>(container.data(), container.size()));
+  }
+
+  // typed view over bytes that already hold T objects, e.g. a mapped buffer written through
+  // as_bytes. the data must be aligned for T and its size a multiple of sizeof(T)
+  template<typename T>
+  inline span<const T> from_bytes(span<const std::byte> bytes)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "from_bytes requires a trivially copyable type");
+    assert(bytes.size() % sizeof(T) == 0);
+    assert(reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) == 0);
+    return span<const T>(reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T));
+  }
+
+  template<typename T>
+  inline span<T> from_writable_bytes(span<std::byte> bytes)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "from_writable_bytes requires a trivially copyable type");
+    assert(bytes.size() % sizeof(T) == 0);
+    assert(reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) == 0);
+    return span<T>(reinterpret_cast<T*>(bytes.data()), bytes.size() / sizeof(T));
+  }
+
+#pragma endregion
+}
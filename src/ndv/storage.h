@@ -0,0 +1,401 @@
+#pragma once
+
+#include <ndv/span.h>
+#include <ndv/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Compact component types for vertex and instance streams: IEEE half floats (float16), snorm16
+// ([-1, 1]) and unorm8 ([0, 1]). They are storage only. Each converts implicitly to float, and
+// arithmetic on a Vec of them widens to Vec<N, float>:
+//
+//   Vec3 p = m_scale * positions[i] + offset; // positions is a span<const Vec3h>
+//
+// Whole streams are converted with pack() and unpack(), using F16C and SSE2 where available.
+namespace ndv
+{
+#pragma region "Storage Definitions"
+  struct float16
+  {
+    std::uint16_t bits;
+
+    float16() = default;
+    explicit float16(float f);
+    operator float() const;
+  };
+
+  struct snorm16
+  {
+    std::int16_t bits;
+
+    snorm16() = default;
+    explicit snorm16(float f);
+    operator float() const;
+  };
+
+  struct unorm8
+  {
+    std::uint8_t bits;
+
+    unorm8() = default;
+    explicit unorm8(float f);
+    operator float() const;
+  };
+
+  using Vec2h = Vec<2, float16>;
+  using Vec3h = Vec<3, float16>;
+  using Vec4h = Vec<4, float16>;
+  using Vec2snorm16 = Vec<2, snorm16>;
+  using Vec3snorm16 = Vec<3, snorm16>;
+  using Vec4snorm16 = Vec<4, snorm16>;
+  using Vec2unorm8 = Vec<2, unorm8>;
+  using Vec3unorm8 = Vec<3, unorm8>;
+  using Vec4unorm8 = Vec<4, unorm8>;
+
+  namespace detail
+  {
+    template<typename T> struct is_storage : std::false_type {};
+    template<> struct is_storage<float16> : std::true_type {};
+    template<> struct is_storage<snorm16> : std::true_type {};
+    template<> struct is_storage<unorm8> : std::true_type {};
+    template<typename T> constexpr bool is_storage_v = is_storage<T>::value;
+
+    // round to nearest even, overflow to infinity, NaN stays NaN
+    inline std::uint16_t float_to_half(float f)
+    {
+      std::uint32_t u;
+      std::memcpy(&u, &f, sizeof(u));
+      const std::uint32_t sign = u & 0x80000000u;
+      u ^= sign;
+
+      std::uint32_t h;
+      if (u >= 0x47800000u) // 2^16, Inf or NaN after rounding
+        h = (u > 0x7f800000u) ? 0x7e00u : 0x7c00u;
+      else if (u < 0x38800000u) // below 2^-14, subnormal or zero
+      {
+        // adding 0.5 aligns the 10 mantissa bits at the bottom, the FPU does the rounding
+        float v;
+        std::memcpy(&v, &u, sizeof(v));
+        v += 0.5f;
+        std::memcpy(&h, &v, sizeof(h));
+        h -= 0x3f000000u;
+      }
+      else
+      {
+        const std::uint32_t odd = (u >> 13) & 1;
+        h = (u + 0xc8000fffu + odd) >> 13; // rebias the exponent and round
+      }
+      return std::uint16_t(h | (sign >> 16));
+    }
+
+    inline float half_to_float(std::uint16_t h)
+    {
+      std::uint32_t u = std::uint32_t(h & 0x7fffu) << 13;
+      const std::uint32_t exp = u & 0x0f800000u;
+      u += 0x38000000u; // rebias the exponent
+      if (exp == 0x0f800000u) // Inf or NaN
+        u += 0x38000000u;
+      else if (exp == 0) // subnormal or zero, renormalized by the FPU
+      {
+        u += 0x00800000u;
+        float f;
+        std::memcpy(&f, &u, sizeof(f));
+        f -= 6.10351562e-05f; // 2^-14
+        std::memcpy(&u, &f, sizeof(u));
+      }
+      u |= std::uint32_t(h & 0x8000u) << 16;
+      float f;
+      std::memcpy(&f, &u, sizeof(f));
+      return f;
+    }
+
+    template<int N, typename T>
+    inline float widen_at(const Vec<N, T>& v, int i) { return float(v[i]); }
+    template<int N>
+    inline float widen_at(float s, int) { return s; }
+
+    // lhs op rhs in float, either side may be a Vec of any component type or a float
+    template<int N, typename L, typename R, typename Op>
+    inline Vec<N, float> widen_apply(const L& lhs, const R& rhs, Op op)
+    {
+      return make_vec<N, float>([&](int i) { return op(widen_at<N>(lhs, i), widen_at<N>(rhs, i)); });
+    }
+
+    struct widen_add { float operator()(float lhs, float rhs) const { return lhs + rhs; } };
+    struct widen_sub { float operator()(float lhs, float rhs) const { return lhs - rhs; } };
+    struct widen_mul { float operator()(float lhs, float rhs) const { return lhs * rhs; } };
+    struct widen_div { float operator()(float lhs, float rhs) const { return lhs / rhs; } };
+  }
+
+#pragma endregion
+#pragma region "Storage Methods"
+  inline float16::float16(float f) : bits(
+#if defined(NDV_SIMD_F16C)
+    std::uint16_t(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT))
+#else
+    detail::float_to_half(f)
+#endif
+  ) {}
+
+  inline float16::operator float() const
+  {
+#if defined(NDV_SIMD_F16C)
+    return _cvtsh_ss(bits);
+#else
+    return detail::half_to_float(bits);
+#endif
+  }
+
+  // out of range values saturate, rounding is to nearest even like the SIMD conversions. NaN
+  // becomes 0
+  inline snorm16::snorm16(float f) : bits(std::isnan(f) ? 0 : std::int16_t(std::lrint(std::clamp(f, -1.0f, 1.0f) * 32767.0f))) {}
+
+  // -32768 and -32767 both decode to -1
+  inline snorm16::operator float() const
+  {
+    return float(std::max<int>(bits, -32767)) * (1.0f / 32767.0f);
+  }
+
+  inline unorm8::unorm8(float f) : bits(std::isnan(f) ? 0 : std::uint8_t(std::lrint(std::clamp(f, 0.0f, 1.0f) * 255.0f))) {}
+
+  inline unorm8::operator float() const
+  {
+    return float(bits) * (1.0f / 255.0f);
+  }
+
+#pragma endregion
+#pragma region "Widening Methods"
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> widen(const Vec<N, S>& rhs)
+  {
+    return detail::widen_apply<N>(rhs, 0.0f, [](float lhs, float) { return lhs; });
+  }
+
+  template<typename S, int N, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, S> narrow(const Vec<N, float>& rhs)
+  {
+    Vec<N, S> result{};
+    for (int i = 0; i < N; i++)
+      result[i] = S(rhs[i]);
+    return result;
+  }
+
+  // one float operand, the other a storage Vec
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator+(const Vec<N, float>& lhs, const Vec<N, S>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_add()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator+(const Vec<N, S>& lhs, const Vec<N, float>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_add()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator-(const Vec<N, float>& lhs, const Vec<N, S>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_sub()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator-(const Vec<N, S>& lhs, const Vec<N, float>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_sub()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator*(const Vec<N, float>& lhs, const Vec<N, S>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_mul()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator*(const Vec<N, S>& lhs, const Vec<N, float>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_mul()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator/(const Vec<N, float>& lhs, const Vec<N, S>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_div()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator/(const Vec<N, S>& lhs, const Vec<N, float>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_div()); }
+
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator*(const Vec<N, S>& lhs, float rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_mul()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator*(float lhs, const Vec<N, S>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_mul()); }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float> operator/(const Vec<N, S>& lhs, float rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_div()); }
+
+  // accumulating into a float Vec
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float>& operator+=(Vec<N, float>& lhs, const Vec<N, S>& rhs) { return lhs = lhs + rhs; }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float>& operator-=(Vec<N, float>& lhs, const Vec<N, S>& rhs) { return lhs = lhs - rhs; }
+  template<int N, typename S, typename = std::enable_if_t<detail::is_storage_v<S>>>
+  inline Vec<N, float>& operator*=(Vec<N, float>& lhs, const Vec<N, S>& rhs) { return lhs = lhs * rhs; }
+
+  // both operands in storage. these name the component type so they are preferred over the
+  // same-type Vec operators, which would narrow the result back
+  template<int N> inline Vec<N, float> operator+(const Vec<N, float16>& lhs, const Vec<N, float16>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_add()); }
+  template<int N> inline Vec<N, float> operator-(const Vec<N, float16>& lhs, const Vec<N, float16>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_sub()); }
+  template<int N> inline Vec<N, float> operator*(const Vec<N, float16>& lhs, const Vec<N, float16>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_mul()); }
+  template<int N> inline Vec<N, float> operator+(const Vec<N, snorm16>& lhs, const Vec<N, snorm16>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_add()); }
+  template<int N> inline Vec<N, float> operator-(const Vec<N, snorm16>& lhs, const Vec<N, snorm16>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_sub()); }
+  template<int N> inline Vec<N, float> operator*(const Vec<N, snorm16>& lhs, const Vec<N, snorm16>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_mul()); }
+  template<int N> inline Vec<N, float> operator+(const Vec<N, unorm8>& lhs, const Vec<N, unorm8>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_add()); }
+  template<int N> inline Vec<N, float> operator-(const Vec<N, unorm8>& lhs, const Vec<N, unorm8>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_sub()); }
+  template<int N> inline Vec<N, float> operator*(const Vec<N, unorm8>& lhs, const Vec<N, unorm8>& rhs) { return detail::widen_apply<N>(lhs, rhs, detail::widen_mul()); }
+
+#pragma endregion
+#pragma region "Bulk Conversion Methods"
+  // out[i] = float16(in[i]), 4 floats per F16C conversion
+  inline void pack(span<const float> in, span<float16> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = out.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_F16C)
+    for (; i < n / 4 * 4; i += 4)
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out.data() + i), _mm_cvtps_ph(_mm_loadu_ps(in.data() + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+    for (; i < n; i++)
+      out[i] = float16(in[i]);
+  }
+
+  inline void unpack(span<const float16> in, span<float> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = out.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_F16C)
+    for (; i < n / 4 * 4; i += 4)
+      _mm_storeu_ps(out.data() + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in.data() + i))));
+#endif
+    for (; i < n; i++)
+      out[i] = float(in[i]);
+  }
+
+  // 8 values per iteration, rounding and saturation come from cvtps and packs
+  inline void pack(span<const float> in, span<snorm16> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = out.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    const __m128 scale = _mm_set1_ps(32767.0f);
+    const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f);
+    // the ordered compare masks NaN lanes to 0 as the scalar constructor does, max alone would
+    // return lo for them
+    const auto clamp = [&](const float* p) {
+      const __m128 v = _mm_loadu_ps(p);
+      return _mm_min_ps(_mm_max_ps(_mm_and_ps(v, _mm_cmpord_ps(v, v)), lo), hi);
+    };
+    for (; i < n / 8 * 8; i += 8)
+    {
+      const __m128 a = clamp(in.data() + i);
+      const __m128 b = clamp(in.data() + i + 4);
+      const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(a, scale)), _mm_cvtps_epi32(_mm_mul_ps(b, scale)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), packed);
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = snorm16(in[i]);
+  }
+
+  inline void unpack(span<const snorm16> in, span<float> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = out.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    const __m128 scale = _mm_set1_ps(1.0f / 32767.0f);
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    for (; i < n / 8 * 8; i += 8)
+    {
+      // sign-extends by unpacking each value into the top half of a 32-bit lane
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+      const __m128 a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+      const __m128 b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+      _mm_storeu_ps(out.data() + i, _mm_max_ps(_mm_mul_ps(a, scale), lo));
+      _mm_storeu_ps(out.data() + i + 4, _mm_max_ps(_mm_mul_ps(b, scale), lo));
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = float(in[i]);
+  }
+
+  // 16 values per iteration
+  inline void pack(span<const float> in, span<unorm8> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = out.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(1.0f);
+    const auto quantize = [&](const float* p) {
+      return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(p), lo), hi), scale));
+    };
+    for (; i < n / 16 * 16; i += 16)
+    {
+      const __m128i a = _mm_packs_epi32(quantize(in.data() + i), quantize(in.data() + i + 4));
+      const __m128i b = _mm_packs_epi32(quantize(in.data() + i + 8), quantize(in.data() + i + 12));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), _mm_packus_epi16(a, b));
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = unorm8(in[i]);
+  }
+
+  inline void unpack(span<const unorm8> in, span<float> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = out.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i < n / 16 * 16; i += 16)
+    {
+      const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+      const __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+      const __m128i words[4] = {_mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero), _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+      for (int k = 0; k < 4; k++)
+        _mm_storeu_ps(out.data() + i + 4 * k, _mm_mul_ps(_mm_cvtepi32_ps(words[k]), scale));
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = float(in[i]);
+  }
+
+  namespace detail
+  {
+    // Vec streams are converted as flat component arrays
+    template<int N, typename S>
+    inline void pack_vecs(span<const Vec<N, float>> in, span<Vec<N, S>> out)
+    {
+      pack(span<const float>(reinterpret_cast<const float*>(in.data()), N * in.size()),
+        span<S>(reinterpret_cast<S*>(out.data()), N * out.size()));
+    }
+
+    template<int N, typename S>
+    inline void unpack_vecs(span<const Vec<N, S>> in, span<Vec<N, float>> out)
+    {
+      unpack(span<const S>(reinterpret_cast<const S*>(in.data()), N * in.size()),
+        span<float>(reinterpret_cast<float*>(out.data()), N * out.size()));
+    }
+  }
+
+  inline void pack(span<const Vec<2, float>> in, span<Vec2h> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<3, float>> in, span<Vec3h> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<4, float>> in, span<Vec4h> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<2, float>> in, span<Vec2snorm16> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<3, float>> in, span<Vec3snorm16> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<4, float>> in, span<Vec4snorm16> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<2, float>> in, span<Vec2unorm8> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<3, float>> in, span<Vec3unorm8> out) { detail::pack_vecs(in, out); }
+  inline void pack(span<const Vec<4, float>> in, span<Vec4unorm8> out) { detail::pack_vecs(in, out); }
+
+  inline void unpack(span<const Vec2h> in, span<Vec<2, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec3h> in, span<Vec<3, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec4h> in, span<Vec<4, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec2snorm16> in, span<Vec<2, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec3snorm16> in, span<Vec<3, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec4snorm16> in, span<Vec<4, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec2unorm8> in, span<Vec<2, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec3unorm8> in, span<Vec<3, float>> out) { detail::unpack_vecs(in, out); }
+  inline void unpack(span<const Vec4unorm8> in, span<Vec<4, float>> out) { detail::unpack_vecs(in, out); }
+
+#pragma endregion
+#pragma region "Layout Checks"
+  // storage Vecs are tightly packed like the float ones, so streams can be viewed as flat arrays
+  static_assert(sizeof(float16) == 2 && sizeof(snorm16) == 2 && sizeof(unorm8) == 1);
+  static_assert(std::is_trivially_copyable_v<Vec3h> && std::is_standard_layout_v<Vec3h>);
+  static_assert(sizeof(Vec3h) == 6 && sizeof(Vec4h) == 8 && sizeof(Vec4snorm16) == 8 && sizeof(Vec4unorm8) == 4);
+
+#pragma endregion
+}
@@ -0,0 +1,395 @@
+#pragma once
+
+#include <ndv/execution.h>
+#include <ndv/mat.h>
+#include <ndv/quat.h>
+#include <ndv/span.h>
+#include <ndv/vec.h>
+#include <ndv/vec_array.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "Batch Transform Methods"
+  // Batched transforms of vectors by a 4x4 matrix. The matrix is read into locals once and every
+  // element is read before its output is written, so out may be the same span as in (in place).
+
+  // out[i] = (m * (in[i], 1)).xyz, divided by w unless the matrix is affine
+  template<typename T>
+  inline void transform_points(const Mat<4, 4, T>& m, span<const Vec<3, type_identity_t<T>>> in, span<Vec<3, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
+    const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
+    const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
+    const T m30 = m[3][0], m31 = m[3][1], m32 = m[3][2], m33 = m[3][3];
+    const std::size_t n = in.size();
+
+    if (check_affine(m))
+    {
+      for (std::size_t i = 0; i < n; i++)
+      {
+        const T x = in[i].x, y = in[i].y, z = in[i].z;
+        out[i].x = m00 * x + m01 * y + m02 * z + m03;
+        out[i].y = m10 * x + m11 * y + m12 * z + m13;
+        out[i].z = m20 * x + m21 * y + m22 * z + m23;
+      }
+    }
+    else
+    {
+      for (std::size_t i = 0; i < n; i++)
+      {
+        const T x = in[i].x, y = in[i].y, z = in[i].z;
+        const T w = m30 * x + m31 * y + m32 * z + m33;
+        out[i].x = (m00 * x + m01 * y + m02 * z + m03) / w;
+        out[i].y = (m10 * x + m11 * y + m12 * z + m13) / w;
+        out[i].z = (m20 * x + m21 * y + m22 * z + m23) / w;
+      }
+    }
+  }
+
+  // out[i] = (m * (in[i], 0)).xyz, translation and projection are ignored
+  template<typename T>
+  inline void transform_directions(const Mat<4, 4, T>& m, span<const Vec<3, type_identity_t<T>>> in, span<Vec<3, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
+    const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
+    const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
+    const std::size_t n = in.size();
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+      const T x = in[i].x, y = in[i].y, z = in[i].z;
+      out[i].x = m00 * x + m01 * y + m02 * z;
+      out[i].y = m10 * x + m11 * y + m12 * z;
+      out[i].z = m20 * x + m21 * y + m22 * z;
+    }
+  }
+
+  // out[i] = m * in[i], no perspective divide
+  template<typename T>
+  inline void transform_vec4(const Mat<4, 4, T>& m, span<const Vec<4, type_identity_t<T>>> in, span<Vec<4, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
+    const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
+    const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
+    const T m30 = m[3][0], m31 = m[3][1], m32 = m[3][2], m33 = m[3][3];
+    const std::size_t n = in.size();
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+      const T x = in[i].x, y = in[i].y, z = in[i].z, w = in[i].w;
+      out[i].x = m00 * x + m01 * y + m02 * z + m03 * w;
+      out[i].y = m10 * x + m11 * y + m12 * z + m13 * w;
+      out[i].z = m20 * x + m21 * y + m22 * z + m23 * w;
+      out[i].w = m30 * x + m31 * y + m32 * z + m33 * w;
+    }
+  }
+
+  // out[i] = rotate(in[i], q), q must be normalized
+  inline void rotate(span<const Vec<3, float>> in, const Quat& q, span<Vec<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+    const simd::QuatLanes lanes(q.w, q.x, q.y, q.z);
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 x, y, z;
+      simd::load_xyz4(src + 3 * i, x, y, z);
+      lanes.rotate(x, y, z);
+      simd::store_xyz4(dst + 3 * i, x, y, z);
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = rotate(in[i], q);
+  }
+
+  // SoA variant, result may be the same array as in
+  inline void rotate(const VecArray<3, float>& in, const Quat& q, VecArray<3, float>& result)
+  {
+    const std::size_t n = in.size();
+    if (&result != &in)
+      result.resize(n);
+
+    const float* ix = in.component(0);
+    const float* iy = in.component(1);
+    const float* iz = in.component(2);
+    float* rx = result.component(0);
+    float* ry = result.component(1);
+    float* rz = result.component(2);
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    const simd::QuatLanes lanes(q.w, q.x, q.y, q.z);
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 x = _mm_load_ps(ix + i), y = _mm_load_ps(iy + i), z = _mm_load_ps(iz + i);
+      lanes.rotate(x, y, z);
+      _mm_store_ps(rx + i, x);
+      _mm_store_ps(ry + i, y);
+      _mm_store_ps(rz + i, z);
+    }
+#endif
+    for (; i < n; i++)
+    {
+      const Vec<3, float> r = rotate(Vec<3, float>(ix[i], iy[i], iz[i]), q);
+      rx[i] = r.x;
+      ry[i] = r.y;
+      rz[i] = r.z;
+    }
+  }
+
+  // out[i] = normalize(in[i]), in may not hold zero vectors
+  inline void normalize(span<const Vec<3, float>> in, span<Vec<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 x, y, z;
+      simd::load_xyz4(src + 3 * i, x, y, z);
+      const __m128 len = _mm_sqrt_ps(simd::madd(x, x, simd::madd(y, y, _mm_mul_ps(z, z))));
+      simd::store_xyz4(dst + 3 * i, _mm_div_ps(x, len), _mm_div_ps(y, len), _mm_div_ps(z, len));
+    }
+#endif
+    for (; i < n; i++)
+    {
+      const Vec<3, float> v = in[i];
+      const float len = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+      out[i] = Vec<3, float>(v.x / len, v.y / len, v.z / len);
+    }
+  }
+
+  // out[i] = to_mat3(in[i]), quaternions must be normalized
+  inline void to_mat3(span<const Quat> in, span<Mat<3, 3, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = to_mat3(in[i]);
+  }
+
+  // out[i] = to_mat4(in[i]), quaternions must be normalized
+  inline void to_mat4(span<const Quat> in, span<Mat<4, 4, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    std::size_t i = 0;
+#if defined(NDV_SIMD_SSE)
+    // four quaternions are transposed into w, x, y, z lanes, and the lanes of each matrix row are
+    // transposed back into the rows of four matrices
+    const float* src = reinterpret_cast<const float*>(in.data());
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 row3 = _mm_set_ps(1, 0, 0, 0);
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 w, x, y, z;
+      simd::load_transpose4(src + 4 * i, w, x, y, z);
+
+      const __m128 x2 = _mm_add_ps(x, x), y2 = _mm_add_ps(y, y), z2 = _mm_add_ps(z, z);
+      const __m128 xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+      const __m128 xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+      const __m128 wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+
+      __m128 r00 = _mm_sub_ps(one, _mm_add_ps(yy, zz)), r01 = _mm_sub_ps(xy, wz), r02 = _mm_add_ps(xz, wy), r03 = zero;
+      __m128 r10 = _mm_add_ps(xy, wz), r11 = _mm_sub_ps(one, _mm_add_ps(xx, zz)), r12 = _mm_sub_ps(yz, wx), r13 = zero;
+      __m128 r20 = _mm_sub_ps(xz, wy), r21 = _mm_add_ps(yz, wx), r22 = _mm_sub_ps(one, _mm_add_ps(xx, yy)), r23 = zero;
+      _MM_TRANSPOSE4_PS(r00, r01, r02, r03);
+      _MM_TRANSPOSE4_PS(r10, r11, r12, r13);
+      _MM_TRANSPOSE4_PS(r20, r21, r22, r23);
+
+      const __m128 rows0[4] = {r00, r01, r02, r03};
+      const __m128 rows1[4] = {r10, r11, r12, r13};
+      const __m128 rows2[4] = {r20, r21, r22, r23};
+      for (int k = 0; k < 4; k++)
+      {
+        out[i + k].row[0].simd = rows0[k];
+        out[i + k].row[1].simd = rows1[k];
+        out[i + k].row[2].simd = rows2[k];
+        out[i + k].row[3].simd = row3;
+      }
+    }
+#endif
+    for (; i < n; i++)
+      out[i] = to_mat4(in[i]);
+  }
+
+  // out[i] = from_matrix(in[i]), the matrices must be rotations
+  inline void from_matrix(span<const Mat<3, 3, float>> in, span<Quat> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = from_matrix(in[i]);
+  }
+
+  inline void from_matrix(span<const Mat<4, 4, float>> in, span<Quat> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = from_matrix(in[i]);
+  }
+
+#pragma endregion
+#if defined(NDV_SIMD_SSE)
+#pragma region "Batch Transform SIMD Methods"
+  // four points per step: 12 packed floats are deinterleaved into x, y, z lanes, the matrix
+  // elements stay broadcast in registers, and the last n % 4 elements use Mat4 * Vec4
+  template<>
+  inline void transform_points(const Mat<4, 4, float>& m, span<const Vec<3, float>> in, span<Vec<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    const std::size_t n4 = n & ~std::size_t(3);
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+
+    const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]), m03 = _mm_set1_ps(m[0][3]);
+    const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]), m13 = _mm_set1_ps(m[1][3]);
+    const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]), m23 = _mm_set1_ps(m[2][3]);
+
+    const bool affine = check_affine(m);
+    if (affine)
+    {
+      for (std::size_t i = 0; i < n4; i += 4)
+      {
+        __m128 x, y, z;
+        simd::load_xyz4(src + 3 * i, x, y, z);
+        const __m128 rx = simd::madd(m00, x, simd::madd(m01, y, simd::madd(m02, z, m03)));
+        const __m128 ry = simd::madd(m10, x, simd::madd(m11, y, simd::madd(m12, z, m13)));
+        const __m128 rz = simd::madd(m20, x, simd::madd(m21, y, simd::madd(m22, z, m23)));
+        simd::store_xyz4(dst + 3 * i, rx, ry, rz);
+      }
+    }
+    else
+    {
+      const __m128 m30 = _mm_set1_ps(m[3][0]), m31 = _mm_set1_ps(m[3][1]), m32 = _mm_set1_ps(m[3][2]), m33 = _mm_set1_ps(m[3][3]);
+      for (std::size_t i = 0; i < n4; i += 4)
+      {
+        __m128 x, y, z;
+        simd::load_xyz4(src + 3 * i, x, y, z);
+        const __m128 rx = simd::madd(m00, x, simd::madd(m01, y, simd::madd(m02, z, m03)));
+        const __m128 ry = simd::madd(m10, x, simd::madd(m11, y, simd::madd(m12, z, m13)));
+        const __m128 rz = simd::madd(m20, x, simd::madd(m21, y, simd::madd(m22, z, m23)));
+        const __m128 rw = simd::madd(m30, x, simd::madd(m31, y, simd::madd(m32, z, m33)));
+        simd::store_xyz4(dst + 3 * i, _mm_div_ps(rx, rw), _mm_div_ps(ry, rw), _mm_div_ps(rz, rw));
+      }
+    }
+
+    for (std::size_t i = n4; i < n; i++)
+    {
+      const Vec<4, float> r = m * Vec<4, float>(in[i].x, in[i].y, in[i].z, 1);
+      const float w = affine ? 1.0f : r.w;
+      out[i] = Vec<3, float>(r.x / w, r.y / w, r.z / w);
+    }
+  }
+
+  template<>
+  inline void transform_directions(const Mat<4, 4, float>& m, span<const Vec<3, float>> in, span<Vec<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    const std::size_t n4 = n & ~std::size_t(3);
+    const float* src = reinterpret_cast<const float*>(in.data());
+    float* dst = reinterpret_cast<float*>(out.data());
+
+    const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]);
+    const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]);
+    const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]);
+
+    for (std::size_t i = 0; i < n4; i += 4)
+    {
+      __m128 x, y, z;
+      simd::load_xyz4(src + 3 * i, x, y, z);
+      const __m128 rx = simd::madd(m00, x, simd::madd(m01, y, _mm_mul_ps(m02, z)));
+      const __m128 ry = simd::madd(m10, x, simd::madd(m11, y, _mm_mul_ps(m12, z)));
+      const __m128 rz = simd::madd(m20, x, simd::madd(m21, y, _mm_mul_ps(m22, z)));
+      simd::store_xyz4(dst + 3 * i, rx, ry, rz);
+    }
+
+    for (std::size_t i = n4; i < n; i++)
+    {
+      const Vec<4, float> r = m * Vec<4, float>(in[i].x, in[i].y, in[i].z, 0);
+      out[i] = Vec<3, float>(r.x, r.y, r.z);
+    }
+  }
+
+  // Vec4 is a single register, so each element is one row-broadcast product against the columns
+  template<>
+  inline void transform_vec4(const Mat<4, 4, float>& m, span<const Vec<4, float>> in, span<Vec<4, float>> out)
+  {
+    assert(in.size() == out.size());
+    __m128 c0 = m.row[0].simd, c1 = m.row[1].simd, c2 = m.row[2].simd, c3 = m.row[3].simd;
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i].simd = simd::row_mul(in[i].simd, c0, c1, c2, c3);
+  }
+
+#pragma endregion
+#endif
+#pragma region "Parallel Batch Transform Methods"
+  // the kernels above under an execution policy (see execution.h), block by block
+  template<typename Policy, typename T, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void transform_points(const Policy& policy, const Mat<4, 4, T>& m, span<const Vec<3, type_identity_t<T>>> in, span<Vec<3, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    detail::for_each_block(policy, in.size(), detail::block_size(2 * sizeof(Vec<3, T>)), [&](std::size_t begin, std::size_t end) {
+      transform_points(m, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+    });
+  }
+
+  template<typename Policy, typename T, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void transform_directions(const Policy& policy, const Mat<4, 4, T>& m, span<const Vec<3, type_identity_t<T>>> in, span<Vec<3, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    detail::for_each_block(policy, in.size(), detail::block_size(2 * sizeof(Vec<3, T>)), [&](std::size_t begin, std::size_t end) {
+      transform_directions(m, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+    });
+  }
+
+  template<typename Policy, typename T, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void transform_vec4(const Policy& policy, const Mat<4, 4, T>& m, span<const Vec<4, type_identity_t<T>>> in, span<Vec<4, type_identity_t<T>>> out)
+  {
+    assert(in.size() == out.size());
+    detail::for_each_block(policy, in.size(), detail::block_size(2 * sizeof(Vec<4, T>)), [&](std::size_t begin, std::size_t end) {
+      transform_vec4(m, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+    });
+  }
+
+  template<typename Policy, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void rotate(const Policy& policy, span<const Vec<3, float>> in, const Quat& q, span<Vec<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    detail::for_each_block(policy, in.size(), detail::block_size(2 * sizeof(Vec<3, float>)), [&](std::size_t begin, std::size_t end) {
+      rotate(in.subspan(begin, end - begin), q, out.subspan(begin, end - begin));
+    });
+  }
+
+  template<typename Policy, typename = std::enable_if_t<is_execution_policy_v<Policy>>>
+  inline void normalize(const Policy& policy, span<const Vec<3, float>> in, span<Vec<3, float>> out)
+  {
+    assert(in.size() == out.size());
+    detail::for_each_block(policy, in.size(), detail::block_size(2 * sizeof(Vec<3, float>)), [&](std::size_t begin, std::size_t end) {
+      normalize(in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+    });
+  }
+
+#pragma endregion
+}
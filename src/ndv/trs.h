@@ -0,0 +1,161 @@
+#pragma once
+
+#include <ndv/mat.h>
+#include <ndv/pose.h>
+#include <ndv/quat.h>
+#include <ndv/span.h>
+#include <ndv/vec.h>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace ndv
+{
+#pragma region "TRS Definitions"
+  // Transform as separate translation, rotation and scale, the matrix T * R * S: scale is applied
+  // first and translation last. Matrices with shear cannot be represented, decompose drops it.
+  struct TRS
+  {
+    Vec<3, float> translation;
+    Quat rotation;
+    Vec<3, float> scale;
+
+    static const TRS identity;
+
+    constexpr TRS() : translation(0), rotation(), scale(1) {}
+    constexpr TRS(const Vec<3, float>& translation, const Quat& rotation, const Vec<3, float>& scale)
+      : translation(translation), rotation(rotation), scale(scale)
+    {
+    }
+  };
+
+#pragma endregion
+#pragma region "TRS Methods"
+  inline constexpr TRS TRS::identity = TRS();
+
+  constexpr bool operator==(const TRS& lhs, const TRS& rhs)
+  {
+    return lhs.translation == rhs.translation && lhs.rotation == rhs.rotation && lhs.scale == rhs.scale;
+  }
+
+  constexpr bool operator!=(const TRS& lhs, const TRS& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  // the columns of the linear block are the rotated axes times the scale, so the scale is their
+  // length and the rotation what is left once they are normalized. a mirroring matrix gets a
+  // negative x scale. a zero scale leaves its axis at zero and the rotation undefined
+  inline TRS decompose(const Mat<3, 4, float>& m)
+  {
+    const Vec<3, float> c0(m[0][0], m[1][0], m[2][0]);
+    const Vec<3, float> c1(m[0][1], m[1][1], m[2][1]);
+    const Vec<3, float> c2(m[0][2], m[1][2], m[2][2]);
+
+    const float det = dot(c0, cross(c1, c2));
+    const float sx = std::copysign(std::sqrt(dot(c0, c0)), det);
+    const float sy = std::sqrt(dot(c1, c1));
+    const float sz = std::sqrt(dot(c2, c2));
+    const float ix = sx != 0 ? 1 / sx : 0, iy = sy != 0 ? 1 / sy : 0, iz = sz != 0 ? 1 / sz : 0;
+
+    Mat<3, 3, float> r{};
+    r.row[0] = Vec<3, float>(c0.x * ix, c1.x * iy, c2.x * iz);
+    r.row[1] = Vec<3, float>(c0.y * ix, c1.y * iy, c2.y * iz);
+    r.row[2] = Vec<3, float>(c0.z * ix, c1.z * iy, c2.z * iz);
+    return TRS(Vec<3, float>(m[0][3], m[1][3], m[2][3]), from_matrix(r), Vec<3, float>(sx, sy, sz));
+  }
+
+  // the matrix must be affine, see check_affine
+  inline TRS decompose(const Mat<4, 4, float>& m)
+  {
+    return decompose(to_affine(m));
+  }
+
+  // to_mat3(rotation) with its columns scaled, written out directly instead of multiplying the
+  // translate, rotate and scale matrices
+  constexpr Mat<3, 4, float> compose_affine(const TRS& rhs)
+  {
+    const Quat& q = rhs.rotation;
+    const Vec<3, float>& s = rhs.scale;
+    const Vec<3, float>& t = rhs.translation;
+    const float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+    const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+    const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+    Mat<3, 4, float> result{};
+    result.row[0] = Vec<4, float>((1 - (yy + zz)) * s.x, (xy - wz) * s.y, (xz + wy) * s.z, t.x);
+    result.row[1] = Vec<4, float>((xy + wz) * s.x, (1 - (xx + zz)) * s.y, (yz - wx) * s.z, t.y);
+    result.row[2] = Vec<4, float>((xz - wy) * s.x, (yz + wx) * s.y, (1 - (xx + yy)) * s.z, t.z);
+    return result;
+  }
+
+  // NOTE: rotation must be normalized
+  constexpr Mat<4, 4, float> compose(const TRS& rhs)
+  {
+    return to_mat4(compose_affine(rhs));
+  }
+
+  // translation and scale are lerped, rotation is slerped along the shorter path with the
+  // polynomial weights of blend_poses (error below 2e-5)
+  inline TRS interpolate_transform(const TRS& a, const TRS& b, float t)
+  {
+    return TRS(
+      a.translation + (b.translation - a.translation) * t,
+      detail::blend_quat<PoseBlend::slerp>(a.rotation, b.rotation, t),
+      a.scale + (b.scale - a.scale) * t);
+  }
+
+#pragma endregion
+#pragma region "Batch TRS Methods"
+  // Batched forms of the above.
+
+  inline void decompose(span<const Mat<4, 4, float>> in, span<TRS> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = decompose(in[i]);
+  }
+
+  inline void decompose(span<const Mat<3, 4, float>> in, span<TRS> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = decompose(in[i]);
+  }
+
+  inline void compose(span<const TRS> in, span<Mat<4, 4, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = compose(in[i]);
+  }
+
+  inline void compose_affine(span<const TRS> in, span<Mat<3, 4, float>> out)
+  {
+    assert(in.size() == out.size());
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = compose_affine(in[i]);
+  }
+
+  // each pair is read before its result is written, so out may be a or b
+  inline void interpolate_transform(span<const TRS> a, span<const TRS> b, float t, span<TRS> out)
+  {
+    assert(a.size() == out.size() && b.size() == out.size());
+    const std::size_t n = out.size();
+    for (std::size_t i = 0; i < n; i++)
+      out[i] = interpolate_transform(a[i], b[i], t);
+  }
+
+#pragma endregion
+#pragma region "Layout Checks"
+  static_assert(std::is_trivially_copyable_v<TRS> && std::is_standard_layout_v<TRS>);
+
+#pragma endregion
+}
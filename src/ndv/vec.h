@@ -1,14 +1,32 @@
 #pragma once
 
 // #include <ndv/math.h>
+#include <ndv/simd.h>
 
 #include <cassert>
 #include <cmath>
 #include <initializer_list>
 #include <type_traits>
+#include <utility>
 
 namespace ndv
 {
+  namespace detail
+  {
+    // std::is_constant_evaluated before C++20. the union-punned and packed paths are skipped
+    // under it, since reading an inactive union member is not a constant expression
+    constexpr bool is_constant_evaluated()
+    {
+#if defined(__cpp_lib_is_constant_evaluated)
+      return std::is_constant_evaluated();
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(__clang__) && __clang_major__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+      return __builtin_is_constant_evaluated();
+#else
+      return false;
+#endif
+    }
+  }
+
 #pragma region "Vec Definitions"
   template<int N, typename T>
   struct Vec
@@ -16,19 +34,18 @@ namespace ndv
     T data[N];
 
     Vec() = default;
-    Vec(T s);
-    Vec(const std::initializer_list<T> args);
-
-    const T& operator[](int i) const;
-    T& operator[](int i);
-
-    Vec& operator=(const Vec& rhs);
-    Vec& operator+=(const Vec& rhs);
-    Vec& operator-=(const Vec& rhs);
-    Vec& operator*=(const Vec& rhs);
-    Vec& operator*=(T rhs);
-    Vec& operator/=(const Vec& rhs);
-    Vec& operator/=(T rhs);
+    constexpr Vec(T s);
+    constexpr Vec(const std::initializer_list<T> args);
+
+    constexpr const T& operator[](int i) const;
+    constexpr T& operator[](int i);
+
+    constexpr Vec& operator+=(const Vec& rhs);
+    constexpr Vec& operator-=(const Vec& rhs);
+    constexpr Vec& operator*=(const Vec& rhs);
+    constexpr Vec& operator*=(T rhs);
+    constexpr Vec& operator/=(const Vec& rhs);
+    constexpr Vec& operator/=(T rhs);
   };
 
   template <typename T>
@@ -46,20 +63,19 @@ namespace ndv
     static const Vec unit_y;
 
     Vec() = default;
-    Vec(T s) : x(s), y(s) {}
-    Vec(T x, T y) : x(x), y(y) {}
-    Vec(const std::initializer_list<T> args);
-
-    const T& operator[](int i) const;
-    T& operator[](int i);
-
-    Vec& operator=(const Vec& rhs);
-    Vec& operator+=(const Vec& rhs);
-    Vec& operator-=(const Vec& rhs);
-    Vec& operator*=(const Vec& rhs);
-    Vec& operator*=(T rhs);
-    Vec& operator/=(const Vec& rhs);
-    Vec& operator/=(T rhs);
+    constexpr Vec(T s) : x(s), y(s) {}
+    constexpr Vec(T x, T y) : x(x), y(y) {}
+    constexpr Vec(const std::initializer_list<T> args);
+
+    constexpr const T& operator[](int i) const;
+    constexpr T& operator[](int i);
+
+    constexpr Vec& operator+=(const Vec& rhs);
+    constexpr Vec& operator-=(const Vec& rhs);
+    constexpr Vec& operator*=(const Vec& rhs);
+    constexpr Vec& operator*=(T rhs);
+    constexpr Vec& operator/=(const Vec& rhs);
+    constexpr Vec& operator/=(T rhs);
   };
   using Vec2 = Vec<2, float>;
   using Vec2i = Vec<2, int>;
@@ -81,20 +97,19 @@ namespace ndv
     static const Vec unit_z;
 
     Vec() = default;
-    Vec(T s) : x(s), y(s), z(s) {}
-    Vec(T x, T y, T z) : x(x), y(y), z(z) {}
-    Vec(const std::initializer_list<T> args);
-
-    const T& operator[](int i) const;
-    T& operator[](int i);
-
-    Vec& operator=(const Vec& rhs);
-    Vec& operator+=(const Vec& rhs);
-    Vec& operator-=(const Vec& rhs);
-    Vec& operator*=(const Vec& rhs);
-    Vec& operator*=(T rhs);
-    Vec& operator/=(const Vec& rhs);
-    Vec& operator/=(T rhs);
+    constexpr Vec(T s) : x(s), y(s), z(s) {}
+    constexpr Vec(T x, T y, T z) : x(x), y(y), z(z) {}
+    constexpr Vec(const std::initializer_list<T> args);
+
+    constexpr const T& operator[](int i) const;
+    constexpr T& operator[](int i);
+
+    constexpr Vec& operator+=(const Vec& rhs);
+    constexpr Vec& operator-=(const Vec& rhs);
+    constexpr Vec& operator*=(const Vec& rhs);
+    constexpr Vec& operator*=(T rhs);
+    constexpr Vec& operator/=(const Vec& rhs);
+    constexpr Vec& operator/=(T rhs);
   };
   using Vec3 = Vec<3, float>;
   using Vec3i = Vec<3, int>;
@@ -110,36 +125,94 @@ namespace ndv
     };
 
     Vec() = default;
-    Vec(T s) : x(s), y(s), z(s), w(s) {}
-    Vec(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) {}
-    Vec(const std::initializer_list<T> args);
-
-    const T& operator[](int i) const;
-    T& operator[](int i);
-
-    Vec& operator=(const Vec& rhs);
-    Vec& operator+=(const Vec& rhs);
-    Vec& operator-=(const Vec& rhs);
-    Vec& operator*=(const Vec& rhs);
-    Vec& operator*=(T rhs);
-    Vec& operator/=(const Vec& rhs);
-    Vec& operator/=(T rhs);
+    constexpr Vec(T s) : x(s), y(s), z(s), w(s) {}
+    constexpr Vec(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vec(const std::initializer_list<T> args);
+
+    constexpr const T& operator[](int i) const;
+    constexpr T& operator[](int i);
+
+    constexpr Vec& operator+=(const Vec& rhs);
+    constexpr Vec& operator-=(const Vec& rhs);
+    constexpr Vec& operator*=(const Vec& rhs);
+    constexpr Vec& operator*=(T rhs);
+    constexpr Vec& operator/=(const Vec& rhs);
+    constexpr Vec& operator/=(T rhs);
   };
   using Vec4 = Vec<4, float>;
   using Vec4i = Vec<4, int>;
   using Vec4d = Vec<4, double>;
 
+#if defined(NDV_SIMD_SSE)
+  // packed specialization, operators and utilities are specialized in "Vec4 SIMD Methods"
+  template<>
+  struct alignas(16) Vec<4, float>
+  {
+    union
+    {
+      struct { float x, y, z, w; };
+      float data[4];
+      __m128 simd;
+    };
+
+    Vec() = default;
+    constexpr Vec(float s) : x(s), y(s), z(s), w(s) {}
+    constexpr Vec(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    explicit Vec(__m128 v) : simd(v) {}
+    constexpr Vec(const std::initializer_list<float> args);
+
+    constexpr const float& operator[](int i) const;
+    constexpr float& operator[](int i);
+
+    constexpr Vec& operator+=(const Vec& rhs);
+    constexpr Vec& operator-=(const Vec& rhs);
+    constexpr Vec& operator*=(const Vec& rhs);
+    constexpr Vec& operator*=(float rhs);
+    constexpr Vec& operator/=(const Vec& rhs);
+    constexpr Vec& operator/=(float rhs);
+  };
+#endif
+
+#if defined(NDV_SIMD_AVX)
+  template<>
+  struct alignas(32) Vec<4, double>
+  {
+    union
+    {
+      struct { double x, y, z, w; };
+      double data[4];
+      __m256d simd;
+    };
+
+    Vec() = default;
+    constexpr Vec(double s) : x(s), y(s), z(s), w(s) {}
+    constexpr Vec(double x, double y, double z, double w) : x(x), y(y), z(z), w(w) {}
+    explicit Vec(__m256d v) : simd(v) {}
+    constexpr Vec(const std::initializer_list<double> args);
+
+    constexpr const double& operator[](int i) const;
+    constexpr double& operator[](int i);
+
+    constexpr Vec& operator+=(const Vec& rhs);
+    constexpr Vec& operator-=(const Vec& rhs);
+    constexpr Vec& operator*=(const Vec& rhs);
+    constexpr Vec& operator*=(double rhs);
+    constexpr Vec& operator/=(const Vec& rhs);
+    constexpr Vec& operator/=(double rhs);
+  };
+#endif
+
 #pragma endregion
 #pragma region "Base Methods"
   template<int N, typename T>
-  inline Vec<N, T>::Vec(T s)
+  constexpr Vec<N, T>::Vec(T s) : data{}
   {
     for (int i = 0; i < N; i++)
       data[i] = s;
   }
 
   template<int N, typename T>
-  inline Vec<N, T>::Vec(const std::initializer_list<T> args)
+  constexpr Vec<N, T>::Vec(const std::initializer_list<T> args) : data{}
   {
     assert(args.size() <= N);
     int i = 0;
@@ -148,29 +221,21 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline const T& Vec<N, T>::operator[](int i) const
+  constexpr const T& Vec<N, T>::operator[](int i) const
   {
     assert(i >= 0 && i < N);
     return data[i];
   }
 
   template<int N, typename T>
-  inline T& Vec<N, T>::operator[](int i)
+  constexpr T& Vec<N, T>::operator[](int i)
   {
     assert(i >= 0 && i < N);
     return data[i];
   }
 
   template<int N, typename T>
-  inline Vec<N, T>& Vec<N, T>::operator=(const Vec<N, T>& rhs)
-  {
-    for (int i = 0; i < N; i++)
-      data[i] = rhs[i];
-    return *this;
-  }
-
-  template<int N, typename T>
-  inline Vec<N, T>& Vec<N, T>::operator+=(const Vec<N, T>& rhs)
+  constexpr Vec<N, T>& Vec<N, T>::operator+=(const Vec<N, T>& rhs)
   {
     for (int i = 0; i < N; i++)
       data[i] += rhs[i];
@@ -178,7 +243,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Vec<N, T>& Vec<N, T>::operator-=(const Vec<N, T>& rhs)
+  constexpr Vec<N, T>& Vec<N, T>::operator-=(const Vec<N, T>& rhs)
   {
     for (int i = 0; i < N; i++)
       data[i] -= rhs[i];
@@ -186,7 +251,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Vec<N, T>& Vec<N, T>::operator*=(const Vec<N, T>& rhs)
+  constexpr Vec<N, T>& Vec<N, T>::operator*=(const Vec<N, T>& rhs)
   {
     for (int i = 0; i < N; i++)
       data[i] *= rhs[i];
@@ -194,7 +259,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Vec<N, T>& Vec<N, T>::operator*=(T rhs)
+  constexpr Vec<N, T>& Vec<N, T>::operator*=(T rhs)
   {
     for (int i = 0; i < N; i++)
       data[i] *= rhs;
@@ -202,7 +267,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Vec<N, T>& Vec<N, T>::operator/=(const Vec<N, T>& rhs)
+  constexpr Vec<N, T>& Vec<N, T>::operator/=(const Vec<N, T>& rhs)
   {
     for (int i = 0; i < N; i++)
       data[i] /= rhs[i];
@@ -210,7 +275,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Vec<N, T>& Vec<N, T>::operator/=(T rhs)
+  constexpr Vec<N, T>& Vec<N, T>::operator/=(T rhs)
   {
     for (int i = 0; i < N; i++)
       data[i] /= rhs;
@@ -218,95 +283,95 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator+(const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator+(const Vec<N, T>& rhs)
   {
     return rhs;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator-(const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator-(const Vec<N, T>& rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = -rhs[i];
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator+(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator+(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs[i] + rhs[i];
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator-(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator-(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs[i] - rhs[i];
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator*(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator*(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs[i] * rhs[i];
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator*(const Vec<N, T>& lhs, T rhs)
+  constexpr Vec<N, T> operator*(const Vec<N, T>& lhs, T rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs[i] * rhs;
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator*(T lhs, const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator*(T lhs, const Vec<N, T>& rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs * rhs[i];
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator/(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator/(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs[i] / rhs[i];
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator/(const Vec<N, T>& lhs, T rhs)
+  constexpr Vec<N, T> operator/(const Vec<N, T>& lhs, T rhs)
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs[i] / rhs;
     return result;
   }
 
   template<int N, typename T>
-  inline Vec<N, T> operator/(T lhs, const Vec<N, T>& rhs)
+  constexpr Vec<N, T> operator/(T lhs, const Vec<N, T>& rhs)
 
   {
-    Vec<N, T> result;
+    Vec<N, T> result{};
     for (int i = 0; i < N; i++)
       result[i] = lhs / rhs[i];
     return result;
   }
 
   template<int N, typename T>
-  inline bool operator==(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr bool operator==(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
     for (int i = 0; i < N; i++)
       if (lhs[i] != rhs[i])
@@ -315,7 +380,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline bool operator!=(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr bool operator!=(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
     for (int i = 0; i < N; i++)
       if (lhs[i] != rhs[i])
@@ -325,44 +390,40 @@ namespace ndv
 
 #pragma endregion
 #pragma region "Vec2 Methods"
-  template<typename T> const Vec<2, T> Vec<2, T>::zero = Vec<2, T>(0);
-  template<typename T> const Vec<2, T> Vec<2, T>::one = Vec<2, T>(1);
-  template<typename T> const Vec<2, T> Vec<2, T>::unit_x = Vec<2, T>(1, 0);
-  template<typename T> const Vec<2, T> Vec<2, T>::unit_y = Vec<2, T>(0, 1);
+  template<typename T> inline constexpr Vec<2, T> Vec<2, T>::zero = Vec<2, T>(0);
+  template<typename T> inline constexpr Vec<2, T> Vec<2, T>::one = Vec<2, T>(1);
+  template<typename T> inline constexpr Vec<2, T> Vec<2, T>::unit_x = Vec<2, T>(1, 0);
+  template<typename T> inline constexpr Vec<2, T> Vec<2, T>::unit_y = Vec<2, T>(0, 1);
   
   template<typename T>
-  inline Vec<2, T>::Vec(const std::initializer_list<T> args)
+  constexpr Vec<2, T>::Vec(const std::initializer_list<T> args) : x(), y()
   {
     assert(args.size() <= 2);
     int i = 0;
     for (auto it = args.begin(); it != args.end() && i < 2; ++it)
-      data[i++] = *it;
+      (*this)[i++] = *it;
   }
 
   template<typename T>
-  inline const T& Vec<2, T>::operator[](int i) const
+  constexpr const T& Vec<2, T>::operator[](int i) const
   {
     assert(i >= 0 && i < 2);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : y;
     return data[i];
   }
 
   template<typename T>
-  inline T& Vec<2, T>::operator[](int i)
+  constexpr T& Vec<2, T>::operator[](int i)
   {
     assert(i >= 0 && i < 2);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : y;
     return data[i];
   }
 
   template<typename T>
-  inline Vec<2, T>& Vec<2, T>::operator=(const Vec<2, T>& rhs)
-  {
-    x = rhs.x;
-    y = rhs.y;
-    return *this;
-  }
-
-  template<typename T>
-  inline Vec<2, T>& Vec<2, T>::operator+=(const Vec<2, T>& rhs)
+  constexpr Vec<2, T>& Vec<2, T>::operator+=(const Vec<2, T>& rhs)
   {
     x += rhs.x;
     y += rhs.y;
@@ -370,7 +431,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<2, T>& Vec<2, T>::operator-=(const Vec<2, T>& rhs)
+  constexpr Vec<2, T>& Vec<2, T>::operator-=(const Vec<2, T>& rhs)
   {
     x -= rhs.x;
     y -= rhs.y;
@@ -378,7 +439,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<2, T>& Vec<2, T>::operator*=(const Vec<2, T>& rhs)
+  constexpr Vec<2, T>& Vec<2, T>::operator*=(const Vec<2, T>& rhs)
   {
     x *= rhs.x;
     y *= rhs.y;
@@ -386,7 +447,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<2, T>& Vec<2, T>::operator*=(T rhs)
+  constexpr Vec<2, T>& Vec<2, T>::operator*=(T rhs)
   {
     x *= rhs;
     y *= rhs;
@@ -394,7 +455,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<2, T>& Vec<2, T>::operator/=(const Vec<2, T>& rhs)
+  constexpr Vec<2, T>& Vec<2, T>::operator/=(const Vec<2, T>& rhs)
   {
     x /= rhs.x;
     y /= rhs.y;
@@ -402,7 +463,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<2, T>& Vec<2, T>::operator/=(T rhs)
+  constexpr Vec<2, T>& Vec<2, T>::operator/=(T rhs)
   {
     x /= rhs;
     y /= rhs;
@@ -411,47 +472,42 @@ namespace ndv
 
 #pragma endregion
 #pragma region "Vec3 Methods"
-  template<typename T> const Vec<3, T> Vec<3, T>::zero = Vec<3, T>(0);
-  template<typename T> const Vec<3, T> Vec<3, T>::one = Vec<3, T>(1);
-  template<typename T> const Vec<3, T> Vec<3, T>::unit_x = Vec<3, T>(1, 0, 0);
-  template<typename T> const Vec<3, T> Vec<3, T>::unit_y = Vec<3, T>(0, 1, 0);
-  template<typename T> const Vec<3, T> Vec<3, T>::unit_z = Vec<3, T>(0, 0, 1);
+  template<typename T> inline constexpr Vec<3, T> Vec<3, T>::zero = Vec<3, T>(0);
+  template<typename T> inline constexpr Vec<3, T> Vec<3, T>::one = Vec<3, T>(1);
+  template<typename T> inline constexpr Vec<3, T> Vec<3, T>::unit_x = Vec<3, T>(1, 0, 0);
+  template<typename T> inline constexpr Vec<3, T> Vec<3, T>::unit_y = Vec<3, T>(0, 1, 0);
+  template<typename T> inline constexpr Vec<3, T> Vec<3, T>::unit_z = Vec<3, T>(0, 0, 1);
 
   template<typename T>
-  inline Vec<3, T>::Vec(const std::initializer_list<T> args)
+  constexpr Vec<3, T>::Vec(const std::initializer_list<T> args) : x(), y(), z()
   {
     // NOTE: we could allow larger lists (with truncation)
     assert(args.size() <= 3);
     int i = 0;
     for (auto it = args.begin(); it != args.end() && i < 3; ++it)
-      data[i++] = *it;
+      (*this)[i++] = *it;
   }
 
   template<typename T>
-  inline const T& Vec<3, T>::operator[](int i) const
+  constexpr const T& Vec<3, T>::operator[](int i) const
   {
     assert(i >= 0 && i < 3);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : z;
     return data[i];
   }
 
   template<typename T>
-  inline T& Vec<3, T>::operator[](int i)
+  constexpr T& Vec<3, T>::operator[](int i)
   {
     assert(i >= 0 && i < 3);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : z;
     return data[i];
   }
 
   template<typename T>
-  inline Vec<3, T>& Vec<3, T>::operator=(const Vec<3, T>& rhs)
-  {
-    x = rhs.x;
-    y = rhs.y;
-    z = rhs.z;
-    return *this;
-  }
-
-  template<typename T>
-  inline Vec<3, T>& Vec<3, T>::operator+=(const Vec<3, T>& rhs)
+  constexpr Vec<3, T>& Vec<3, T>::operator+=(const Vec<3, T>& rhs)
   {
     x += rhs.x;
     y += rhs.y;
@@ -460,7 +516,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<3, T>& Vec<3, T>::operator-=(const Vec<3, T>& rhs)
+  constexpr Vec<3, T>& Vec<3, T>::operator-=(const Vec<3, T>& rhs)
   {
     x -= rhs.x;
     y -= rhs.y;
@@ -469,7 +525,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<3, T>& Vec<3, T>::operator*=(const Vec<3, T>& rhs)
+  constexpr Vec<3, T>& Vec<3, T>::operator*=(const Vec<3, T>& rhs)
   {
     x *= rhs.x;
     y *= rhs.y;
@@ -478,7 +534,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<3, T>& Vec<3, T>::operator*=(T rhs)
+  constexpr Vec<3, T>& Vec<3, T>::operator*=(T rhs)
   {
     x *= rhs;
     y *= rhs;
@@ -487,7 +543,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<3, T>& Vec<3, T>::operator/=(const Vec<3, T>& rhs)
+  constexpr Vec<3, T>& Vec<3, T>::operator/=(const Vec<3, T>& rhs)
   {
     x /= rhs.x;
     y /= rhs.y;
@@ -496,7 +552,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<3, T>& Vec<3, T>::operator/=(T rhs)
+  constexpr Vec<3, T>& Vec<3, T>::operator/=(T rhs)
   {
     x /= rhs;
     y /= rhs;
@@ -507,41 +563,35 @@ namespace ndv
 #pragma endregion
 #pragma region "Vec4 Methods"
   template<typename T>
-  inline Vec<4, T>::Vec(const std::initializer_list<T> args)
+  constexpr Vec<4, T>::Vec(const std::initializer_list<T> args) : x(), y(), z(), w()
   {
     // NOTE: we could allow larger lists (with truncation)
     assert(args.size() <= 4);
     int i = 0;
     for (auto it = args.begin(); it != args.end() && i < 4; ++it)
-      data[i++] = *it;
+      (*this)[i++] = *it;
   }
 
   template<typename T>
-  inline const T& Vec<4, T>::operator[](int i) const
+  constexpr const T& Vec<4, T>::operator[](int i) const
   {
     assert(i >= 0 && i < 4);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : (i == 2) ? z : w;
     return data[i];
   }
 
   template<typename T>
-  inline T& Vec<4, T>::operator[](int i)
+  constexpr T& Vec<4, T>::operator[](int i)
   {
     assert(i >= 0 && i < 4);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : (i == 2) ? z : w;
     return data[i];
   }
 
   template<typename T>
-  inline Vec<4, T>& Vec<4, T>::operator=(const Vec<4, T>& rhs)
-  {
-    x = rhs.x;
-    y = rhs.y;
-    z = rhs.z;
-    w = rhs.w;
-    return *this;
-  }
-
-  template<typename T>
-  inline Vec<4, T>& Vec<4, T>::operator+=(const Vec<4, T>& rhs)
+  constexpr Vec<4, T>& Vec<4, T>::operator+=(const Vec<4, T>& rhs)
   {
     x += rhs.x;
     y += rhs.y;
@@ -551,7 +601,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<4, T>& Vec<4, T>::operator-=(const Vec<4, T>& rhs)
+  constexpr Vec<4, T>& Vec<4, T>::operator-=(const Vec<4, T>& rhs)
   {
     x -= rhs.x;
     y -= rhs.y;
@@ -561,7 +611,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<4, T>& Vec<4, T>::operator*=(const Vec<4, T>& rhs)
+  constexpr Vec<4, T>& Vec<4, T>::operator*=(const Vec<4, T>& rhs)
   {
     x *= rhs.x;
     y *= rhs.y;
@@ -571,7 +621,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<4, T>& Vec<4, T>::operator*=(T rhs)
+  constexpr Vec<4, T>& Vec<4, T>::operator*=(T rhs)
   {
     x *= rhs;
     y *= rhs;
@@ -581,7 +631,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<4, T>& Vec<4, T>::operator/=(const Vec<4, T>& rhs)
+  constexpr Vec<4, T>& Vec<4, T>::operator/=(const Vec<4, T>& rhs)
   {
     x /= rhs.x;
     y /= rhs.y;
@@ -591,7 +641,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<4, T>& Vec<4, T>::operator/=(T rhs)
+  constexpr Vec<4, T>& Vec<4, T>::operator/=(T rhs)
   {
     x /= rhs;
     y /= rhs;
@@ -602,8 +652,28 @@ namespace ndv
 
 #pragma endregion
 #pragma region "Utility Methods"
+  namespace detail
+  {
+    // Vec(fn(0), ..., fn(N - 1)) in one constructor call. a Vec filled in by element stores is
+    // then read back as a whole, which stalls on store forwarding
+    template<int N, typename T, typename F, int... I>
+    constexpr Vec<N, T> make_vec(F&& fn, std::integer_sequence<int, I...>)
+    {
+      if constexpr (N <= 4)
+        return Vec<N, T>(fn(I)...);
+      else
+        return Vec<N, T>{fn(I)...};
+    }
+
+    template<int N, typename T, typename F>
+    constexpr Vec<N, T> make_vec(F&& fn)
+    {
+      return make_vec<N, T>(fn, std::make_integer_sequence<int, N>());
+    }
+  }
+
   template<int N, typename T>
-  inline T length_squared(const Vec<N, T>& rhs)
+  constexpr T length_squared(const Vec<N, T>& rhs)
   {
     T result = 0;
     for (int i = 0; i < N; i++)
@@ -618,7 +688,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline T distance_squared(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr T distance_squared(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
     return length_squared(lhs - rhs);
   }
@@ -636,7 +706,7 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline T dot(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
+  constexpr T dot(const Vec<N, T>& lhs, const Vec<N, T>& rhs)
   {
     T result = 0;
     for (int i = 0; i < N; i++)
@@ -645,7 +715,7 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<3, T> cross(const Vec<3, T>& lhs, const Vec<3, T>& rhs)
+  constexpr Vec<3, T> cross(const Vec<3, T>& lhs, const Vec<3, T>& rhs)
   {
     return Vec<3, T>(
       lhs.y * rhs.z - lhs.z * rhs.y,
@@ -661,13 +731,13 @@ namespace ndv
   }
 
   template<typename T>
-  inline Vec<2, T> perpendicular(const Vec<2, T>& rhs)
+  constexpr Vec<2, T> perpendicular(const Vec<2, T>& rhs)
   {
     return Vec<2, T>(-rhs.y, rhs.x);
   }
 
   template<int N, typename T>
-  inline Vec<N, T> reflect(const Vec<N, T>& vi, const Vec<N, T>& vn)
+  constexpr Vec<N, T> reflect(const Vec<N, T>& vi, const Vec<N, T>& vn)
   {
     return vi - (2 * dot(vn, vi) * vn);
   }
@@ -686,10 +756,510 @@ namespace ndv
   }
 
   template<int N, typename T>
-  inline Vec<N, T> faceforward(const Vec<N, T>& vi, const Vec<N, T>& vn, const Vec<N, T>& vref)
+  constexpr Vec<N, T> faceforward(const Vec<N, T>& vi, const Vec<N, T>& vn, const Vec<N, T>& vref)
   {
     return (dot(vref, vi) < 0) ? vn : -vn;
   }
 
 #pragma endregion
-}
\ No newline at end of file
+#if defined(NDV_SIMD_SSE)
+#pragma region "Vec4 SIMD Methods"
+  constexpr Vec<4, float>::Vec(const std::initializer_list<float> args) : x(), y(), z(), w()
+  {
+    assert(args.size() <= 4);
+    int i = 0;
+    for (auto it = args.begin(); it != args.end() && i < 4; ++it)
+      (*this)[i++] = *it;
+  }
+
+  constexpr const float& Vec<4, float>::operator[](int i) const
+  {
+    assert(i >= 0 && i < 4);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : (i == 2) ? z : w;
+    return data[i];
+  }
+
+  constexpr float& Vec<4, float>::operator[](int i)
+  {
+    assert(i >= 0 && i < 4);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : (i == 2) ? z : w;
+    return data[i];
+  }
+
+  constexpr Vec<4, float>& Vec<4, float>::operator+=(const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x += rhs.x;
+      y += rhs.y;
+      z += rhs.z;
+      w += rhs.w;
+    }
+    else
+      simd = _mm_add_ps(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, float>& Vec<4, float>::operator-=(const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x -= rhs.x;
+      y -= rhs.y;
+      z -= rhs.z;
+      w -= rhs.w;
+    }
+    else
+      simd = _mm_sub_ps(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, float>& Vec<4, float>::operator*=(const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x *= rhs.x;
+      y *= rhs.y;
+      z *= rhs.z;
+      w *= rhs.w;
+    }
+    else
+      simd = _mm_mul_ps(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, float>& Vec<4, float>::operator*=(float rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x *= rhs;
+      y *= rhs;
+      z *= rhs;
+      w *= rhs;
+    }
+    else
+      simd = _mm_mul_ps(simd, _mm_set1_ps(rhs));
+    return *this;
+  }
+
+  constexpr Vec<4, float>& Vec<4, float>::operator/=(const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x /= rhs.x;
+      y /= rhs.y;
+      z /= rhs.z;
+      w /= rhs.w;
+    }
+    else
+      simd = _mm_div_ps(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, float>& Vec<4, float>::operator/=(float rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x /= rhs;
+      y /= rhs;
+      z /= rhs;
+      w /= rhs;
+    }
+    else
+      simd = _mm_div_ps(simd, _mm_set1_ps(rhs));
+    return *this;
+  }
+
+  template<>
+  constexpr Vec<4, float> operator-(const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(-rhs.x, -rhs.y, -rhs.z, -rhs.w);
+    return Vec<4, float>(simd::negate(rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator+(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w);
+    return Vec<4, float>(_mm_add_ps(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator-(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
+    return Vec<4, float>(_mm_sub_ps(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator*(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w);
+    return Vec<4, float>(_mm_mul_ps(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator*(const Vec<4, float>& lhs, float rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs);
+    return Vec<4, float>(_mm_mul_ps(lhs.simd, _mm_set1_ps(rhs)));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator*(float lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z, lhs * rhs.w);
+    return Vec<4, float>(_mm_mul_ps(_mm_set1_ps(lhs), rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator/(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w);
+    return Vec<4, float>(_mm_div_ps(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator/(const Vec<4, float>& lhs, float rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs);
+    return Vec<4, float>(_mm_div_ps(lhs.simd, _mm_set1_ps(rhs)));
+  }
+
+  template<>
+  constexpr Vec<4, float> operator/(float lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, float>(lhs / rhs.x, lhs / rhs.y, lhs / rhs.z, lhs / rhs.w);
+    return Vec<4, float>(_mm_div_ps(_mm_set1_ps(lhs), rhs.simd));
+  }
+
+  template<>
+  constexpr bool operator==(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return (lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z && lhs.w == rhs.w);
+    return (_mm_movemask_ps(_mm_cmpeq_ps(lhs.simd, rhs.simd)) == 0xF);
+  }
+
+  template<>
+  constexpr bool operator!=(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return (lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z || lhs.w != rhs.w);
+    return (_mm_movemask_ps(_mm_cmpeq_ps(lhs.simd, rhs.simd)) != 0xF);
+  }
+
+  template<>
+  constexpr float dot(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
+    return _mm_cvtss_f32(simd::dot(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr float length_squared(const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return rhs.x * rhs.x + rhs.y * rhs.y + rhs.z * rhs.z + rhs.w * rhs.w;
+    return _mm_cvtss_f32(simd::dot(rhs.simd, rhs.simd));
+  }
+
+  template<>
+  inline float length(const Vec<4, float>& rhs)
+  {
+    return _mm_cvtss_f32(_mm_sqrt_ss(simd::dot(rhs.simd, rhs.simd)));
+  }
+
+  template<>
+  constexpr float distance_squared(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return length_squared(lhs - rhs);
+    __m128 d = _mm_sub_ps(lhs.simd, rhs.simd);
+    return _mm_cvtss_f32(simd::dot(d, d));
+  }
+
+  template<>
+  inline float distance(const Vec<4, float>& lhs, const Vec<4, float>& rhs)
+  {
+    __m128 d = _mm_sub_ps(lhs.simd, rhs.simd);
+    return _mm_cvtss_f32(_mm_sqrt_ss(simd::dot(d, d)));
+  }
+
+  template<>
+  inline Vec<4, float> normalize(const Vec<4, float>& rhs)
+  {
+    return Vec<4, float>(_mm_div_ps(rhs.simd, _mm_sqrt_ps(simd::dot(rhs.simd, rhs.simd))));
+  }
+
+#pragma endregion
+#endif
+#if defined(NDV_SIMD_AVX)
+#pragma region "Vec4d SIMD Methods"
+  constexpr Vec<4, double>::Vec(const std::initializer_list<double> args) : x(), y(), z(), w()
+  {
+    assert(args.size() <= 4);
+    int i = 0;
+    for (auto it = args.begin(); it != args.end() && i < 4; ++it)
+      (*this)[i++] = *it;
+  }
+
+  constexpr const double& Vec<4, double>::operator[](int i) const
+  {
+    assert(i >= 0 && i < 4);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : (i == 2) ? z : w;
+    return data[i];
+  }
+
+  constexpr double& Vec<4, double>::operator[](int i)
+  {
+    assert(i >= 0 && i < 4);
+    if (detail::is_constant_evaluated())
+      return (i == 0) ? x : (i == 1) ? y : (i == 2) ? z : w;
+    return data[i];
+  }
+
+  constexpr Vec<4, double>& Vec<4, double>::operator+=(const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x += rhs.x;
+      y += rhs.y;
+      z += rhs.z;
+      w += rhs.w;
+    }
+    else
+      simd = _mm256_add_pd(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, double>& Vec<4, double>::operator-=(const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x -= rhs.x;
+      y -= rhs.y;
+      z -= rhs.z;
+      w -= rhs.w;
+    }
+    else
+      simd = _mm256_sub_pd(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, double>& Vec<4, double>::operator*=(const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x *= rhs.x;
+      y *= rhs.y;
+      z *= rhs.z;
+      w *= rhs.w;
+    }
+    else
+      simd = _mm256_mul_pd(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, double>& Vec<4, double>::operator*=(double rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x *= rhs;
+      y *= rhs;
+      z *= rhs;
+      w *= rhs;
+    }
+    else
+      simd = _mm256_mul_pd(simd, _mm256_set1_pd(rhs));
+    return *this;
+  }
+
+  constexpr Vec<4, double>& Vec<4, double>::operator/=(const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x /= rhs.x;
+      y /= rhs.y;
+      z /= rhs.z;
+      w /= rhs.w;
+    }
+    else
+      simd = _mm256_div_pd(simd, rhs.simd);
+    return *this;
+  }
+
+  constexpr Vec<4, double>& Vec<4, double>::operator/=(double rhs)
+  {
+    if (detail::is_constant_evaluated())
+    {
+      x /= rhs;
+      y /= rhs;
+      z /= rhs;
+      w /= rhs;
+    }
+    else
+      simd = _mm256_div_pd(simd, _mm256_set1_pd(rhs));
+    return *this;
+  }
+
+  template<>
+  constexpr Vec<4, double> operator-(const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(-rhs.x, -rhs.y, -rhs.z, -rhs.w);
+    return Vec<4, double>(simd::negate(rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator+(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w);
+    return Vec<4, double>(_mm256_add_pd(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator-(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
+    return Vec<4, double>(_mm256_sub_pd(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator*(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w);
+    return Vec<4, double>(_mm256_mul_pd(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator*(const Vec<4, double>& lhs, double rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs);
+    return Vec<4, double>(_mm256_mul_pd(lhs.simd, _mm256_set1_pd(rhs)));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator*(double lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z, lhs * rhs.w);
+    return Vec<4, double>(_mm256_mul_pd(_mm256_set1_pd(lhs), rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator/(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w);
+    return Vec<4, double>(_mm256_div_pd(lhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator/(const Vec<4, double>& lhs, double rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs);
+    return Vec<4, double>(_mm256_div_pd(lhs.simd, _mm256_set1_pd(rhs)));
+  }
+
+  template<>
+  constexpr Vec<4, double> operator/(double lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return Vec<4, double>(lhs / rhs.x, lhs / rhs.y, lhs / rhs.z, lhs / rhs.w);
+    return Vec<4, double>(_mm256_div_pd(_mm256_set1_pd(lhs), rhs.simd));
+  }
+
+  template<>
+  constexpr bool operator==(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return (lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z && lhs.w == rhs.w);
+    return (_mm256_movemask_pd(_mm256_cmp_pd(lhs.simd, rhs.simd, _CMP_EQ_OQ)) == 0xF);
+  }
+
+  template<>
+  constexpr bool operator!=(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return (lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z || lhs.w != rhs.w);
+    return (_mm256_movemask_pd(_mm256_cmp_pd(lhs.simd, rhs.simd, _CMP_EQ_OQ)) != 0xF);
+  }
+
+  template<>
+  constexpr double dot(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
+    return simd::dot(lhs.simd, rhs.simd);
+  }
+
+  template<>
+  constexpr double length_squared(const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return rhs.x * rhs.x + rhs.y * rhs.y + rhs.z * rhs.z + rhs.w * rhs.w;
+    return simd::dot(rhs.simd, rhs.simd);
+  }
+
+  template<>
+  inline double length(const Vec<4, double>& rhs)
+  {
+    return std::sqrt(simd::dot(rhs.simd, rhs.simd));
+  }
+
+  template<>
+  constexpr double distance_squared(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    if (detail::is_constant_evaluated())
+      return length_squared(lhs - rhs);
+    __m256d d = _mm256_sub_pd(lhs.simd, rhs.simd);
+    return simd::dot(d, d);
+  }
+
+  template<>
+  inline double distance(const Vec<4, double>& lhs, const Vec<4, double>& rhs)
+  {
+    __m256d d = _mm256_sub_pd(lhs.simd, rhs.simd);
+    return std::sqrt(simd::dot(d, d));
+  }
+
+  template<>
+  inline Vec<4, double> normalize(const Vec<4, double>& rhs)
+  {
+    return Vec<4, double>(_mm256_div_pd(rhs.simd, _mm256_set1_pd(length(rhs))));
+  }
+
+#pragma endregion
+#endif
+#pragma region "Layout Checks"
+  // Vecs are plain data with tightly packed components, so buffers of them can be memcpy'd and
+  // viewed as bytes (see as_bytes in span.h)
+  static_assert(std::is_trivially_copyable_v<Vec2> && std::is_standard_layout_v<Vec2>);
+  static_assert(std::is_trivially_copyable_v<Vec3> && std::is_standard_layout_v<Vec3>);
+  static_assert(std::is_trivially_copyable_v<Vec4> && std::is_standard_layout_v<Vec4>);
+  static_assert(std::is_trivially_copyable_v<Vec4d> && std::is_standard_layout_v<Vec4d>);
+  static_assert(std::is_trivially_copyable_v<Vec<5, float>> && std::is_standard_layout_v<Vec<5, float>>);
+  static_assert(sizeof(Vec2) == 2 * sizeof(float) && sizeof(Vec3) == 3 * sizeof(float) && sizeof(Vec4) == 4 * sizeof(float));
+  static_assert(sizeof(Vec3d) == 3 * sizeof(double) && sizeof(Vec4d) == 4 * sizeof(double));
+
+#pragma endregion
+}
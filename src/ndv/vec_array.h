@@ -0,0 +1,763 @@
+#pragma once
+
+#include <ndv/span.h>
+#include <ndv/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace ndv
+{
+#pragma region "VecArray Definitions"
+  // Structure-of-arrays storage for Vec<N, T>. Each component is a contiguous stream starting on
+  // an `alignment` boundary, so whole-array loops run along a stream and vectorize without gathers.
+  template<int N, typename T>
+  class VecArray
+  {
+  public:
+    static constexpr std::size_t alignment = 64;
+
+    // proxy for a single element, reads and writes through to the component streams
+    class Ref
+    {
+    public:
+      Ref(T* ptr, std::size_t stride) : ptr(ptr), stride(stride) {}
+
+      T& operator[](int c) const;
+      Vec<N, T> value() const;
+      operator Vec<N, T>() const { return value(); }
+
+      const Ref& operator=(const Ref& rhs) const;
+      const Ref& operator=(const Vec<N, T>& rhs) const;
+      const Ref& operator+=(const Vec<N, T>& rhs) const;
+      const Ref& operator-=(const Vec<N, T>& rhs) const;
+      const Ref& operator*=(const Vec<N, T>& rhs) const;
+      const Ref& operator*=(T rhs) const;
+      const Ref& operator/=(const Vec<N, T>& rhs) const;
+      const Ref& operator/=(T rhs) const;
+
+      // found through the proxy, so Ref == Vec, Vec == Ref and Ref == Ref all compare values
+      friend bool operator==(const Vec<N, T>& lhs, const Vec<N, T>& rhs) { return ndv::operator==(lhs, rhs); }
+      friend bool operator!=(const Vec<N, T>& lhs, const Vec<N, T>& rhs) { return ndv::operator!=(lhs, rhs); }
+
+    private:
+      T* ptr;
+      std::size_t stride;
+    };
+
+    VecArray() = default;
+    explicit VecArray(std::size_t size);
+    VecArray(std::size_t size, const Vec<N, T>& fill);
+    explicit VecArray(span<const Vec<N, T>> values);
+    VecArray(const VecArray& rhs);
+    VecArray(VecArray&& rhs) noexcept;
+    ~VecArray();
+
+    VecArray& operator=(const VecArray& rhs);
+    VecArray& operator=(VecArray&& rhs) noexcept;
+
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+
+    void reserve(std::size_t n);
+    void resize(std::size_t n);
+    void resize(std::size_t n, const Vec<N, T>& fill);
+    void clear() { count = 0; }
+    void push_back(const Vec<N, T>& value);
+
+    T* component(int c);
+    const T* component(int c) const;
+    span<T> stream(int c) { return span<T>(component(c), count); }
+    span<const T> stream(int c) const { return span<const T>(component(c), count); }
+
+    Ref operator[](std::size_t i);
+    Vec<N, T> operator[](std::size_t i) const;
+
+    // AoS <-> SoA conversion of a block of elements starting at offset
+    void load(span<const Vec<N, T>> src, std::size_t offset = 0);
+    void store(span<Vec<N, T>> dst, std::size_t offset = 0) const;
+
+    VecArray& operator+=(const VecArray& rhs);
+    VecArray& operator+=(const Vec<N, T>& rhs);
+    VecArray& operator-=(const VecArray& rhs);
+    VecArray& operator-=(const Vec<N, T>& rhs);
+    VecArray& operator*=(const VecArray& rhs);
+    VecArray& operator*=(T rhs);
+    VecArray& operator/=(const VecArray& rhs);
+    VecArray& operator/=(T rhs);
+
+  private:
+    static std::size_t round_capacity(std::size_t n);
+
+    T* streams = nullptr; // N streams of cap elements each
+    std::size_t count = 0;
+    std::size_t cap = 0;
+  };
+  using Vec2Array = VecArray<2, float>;
+  using Vec3Array = VecArray<3, float>;
+  using Vec4Array = VecArray<4, float>;
+
+#pragma endregion
+#pragma region "Ref Methods"
+  template<int N, typename T>
+  inline T& VecArray<N, T>::Ref::operator[](int c) const
+  {
+    assert(c >= 0 && c < N);
+    return ptr[c * stride];
+  }
+
+  template<int N, typename T>
+  inline Vec<N, T> VecArray<N, T>::Ref::value() const
+  {
+    Vec<N, T> result;
+    for (int c = 0; c < N; c++)
+      result[c] = ptr[c * stride];
+    return result;
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator=(const Ref& rhs) const
+  {
+    return (*this = rhs.value());
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator=(const Vec<N, T>& rhs) const
+  {
+    for (int c = 0; c < N; c++)
+      ptr[c * stride] = rhs[c];
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator+=(const Vec<N, T>& rhs) const
+  {
+    for (int c = 0; c < N; c++)
+      ptr[c * stride] += rhs[c];
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator-=(const Vec<N, T>& rhs) const
+  {
+    for (int c = 0; c < N; c++)
+      ptr[c * stride] -= rhs[c];
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator*=(const Vec<N, T>& rhs) const
+  {
+    for (int c = 0; c < N; c++)
+      ptr[c * stride] *= rhs[c];
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator*=(T rhs) const
+  {
+    for (int c = 0; c < N; c++)
+      ptr[c * stride] *= rhs;
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator/=(const Vec<N, T>& rhs) const
+  {
+    for (int c = 0; c < N; c++)
+      ptr[c * stride] /= rhs[c];
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline const typename VecArray<N, T>::Ref& VecArray<N, T>::Ref::operator/=(T rhs) const
+  {
+    for (int c = 0; c < N; c++)
+      ptr[c * stride] /= rhs;
+    return *this;
+  }
+
+#pragma endregion
+#pragma region "Base Methods"
+  template<int N, typename T>
+  inline std::size_t VecArray<N, T>::round_capacity(std::size_t n)
+  {
+    constexpr std::size_t lanes = (alignment > sizeof(T)) ? alignment / sizeof(T) : 1;
+    return ((n + lanes - 1) / lanes) * lanes;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>::VecArray(std::size_t size)
+  {
+    resize(size);
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>::VecArray(std::size_t size, const Vec<N, T>& fill)
+  {
+    resize(size, fill);
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>::VecArray(span<const Vec<N, T>> values)
+  {
+    resize(values.size());
+    load(values);
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>::VecArray(const VecArray<N, T>& rhs)
+  {
+    resize(rhs.count);
+    for (int c = 0; c < N; c++)
+      std::copy(rhs.component(c), rhs.component(c) + count, component(c));
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>::VecArray(VecArray<N, T>&& rhs) noexcept
+    : streams(std::exchange(rhs.streams, nullptr)),
+      count(std::exchange(rhs.count, 0)),
+      cap(std::exchange(rhs.cap, 0))
+  {
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>::~VecArray()
+  {
+    if (streams)
+      ::operator delete(streams, std::align_val_t(alignment));
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator=(const VecArray<N, T>& rhs)
+  {
+    if (&rhs != this)
+    {
+      resize(rhs.count);
+      for (int c = 0; c < N; c++)
+        std::copy(rhs.component(c), rhs.component(c) + count, component(c));
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator=(VecArray<N, T>&& rhs) noexcept
+  {
+    std::swap(streams, rhs.streams);
+    std::swap(count, rhs.count);
+    std::swap(cap, rhs.cap);
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline void VecArray<N, T>::reserve(std::size_t n)
+  {
+    if (n <= cap)
+      return;
+
+    const std::size_t new_cap = round_capacity(n);
+    T* new_streams = static_cast<T*>(::operator new(N * new_cap * sizeof(T), std::align_val_t(alignment)));
+    if (streams)
+    {
+      for (int c = 0; c < N; c++)
+        std::copy(streams + c * cap, streams + c * cap + count, new_streams + c * new_cap);
+      ::operator delete(streams, std::align_val_t(alignment));
+    }
+    streams = new_streams;
+    cap = new_cap;
+  }
+
+  template<int N, typename T>
+  inline void VecArray<N, T>::resize(std::size_t n)
+  {
+    resize(n, Vec<N, T>(0));
+  }
+
+  template<int N, typename T>
+  inline void VecArray<N, T>::resize(std::size_t n, const Vec<N, T>& fill)
+  {
+    reserve(n);
+    if (n > count)
+      for (int c = 0; c < N; c++)
+        std::fill(component(c) + count, component(c) + n, fill[c]);
+    count = n;
+  }
+
+  template<int N, typename T>
+  inline void VecArray<N, T>::push_back(const Vec<N, T>& value)
+  {
+    if (count == cap)
+      reserve(std::max<std::size_t>(2 * cap, 1));
+    for (int c = 0; c < N; c++)
+      component(c)[count] = value[c];
+    count++;
+  }
+
+  template<int N, typename T>
+  inline T* VecArray<N, T>::component(int c)
+  {
+    assert(c >= 0 && c < N);
+    return streams + c * cap;
+  }
+
+  template<int N, typename T>
+  inline const T* VecArray<N, T>::component(int c) const
+  {
+    assert(c >= 0 && c < N);
+    return streams + c * cap;
+  }
+
+  template<int N, typename T>
+  inline typename VecArray<N, T>::Ref VecArray<N, T>::operator[](std::size_t i)
+  {
+    assert(i < count);
+    return Ref(streams + i, cap);
+  }
+
+  template<int N, typename T>
+  inline Vec<N, T> VecArray<N, T>::operator[](std::size_t i) const
+  {
+    assert(i < count);
+    Vec<N, T> result;
+    for (int c = 0; c < N; c++)
+      result[c] = streams[c * cap + i];
+    return result;
+  }
+
+  template<int N, typename T>
+  inline void VecArray<N, T>::load(span<const Vec<N, T>> src, std::size_t offset)
+  {
+    assert(offset <= count && src.size() <= count - offset);
+    const Vec<N, T>* in = src.data();
+    for (int c = 0; c < N; c++)
+    {
+      T* out = component(c) + offset;
+      for (std::size_t i = 0; i < src.size(); i++)
+        out[i] = in[i].data[c];
+    }
+  }
+
+  template<int N, typename T>
+  inline void VecArray<N, T>::store(span<Vec<N, T>> dst, std::size_t offset) const
+  {
+    assert(offset <= count && dst.size() <= count - offset);
+    Vec<N, T>* out = dst.data();
+    for (int c = 0; c < N; c++)
+    {
+      const T* in = component(c) + offset;
+      for (std::size_t i = 0; i < dst.size(); i++)
+        out[i].data[c] = in[i];
+    }
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator+=(const VecArray<N, T>& rhs)
+  {
+    assert(rhs.count == count);
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      const T* b = rhs.component(c);
+      for (std::size_t i = 0; i < count; i++)
+        a[i] += b[i];
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator+=(const Vec<N, T>& rhs)
+  {
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      const T b = rhs[c];
+      for (std::size_t i = 0; i < count; i++)
+        a[i] += b;
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator-=(const VecArray<N, T>& rhs)
+  {
+    assert(rhs.count == count);
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      const T* b = rhs.component(c);
+      for (std::size_t i = 0; i < count; i++)
+        a[i] -= b[i];
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator-=(const Vec<N, T>& rhs)
+  {
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      const T b = rhs[c];
+      for (std::size_t i = 0; i < count; i++)
+        a[i] -= b;
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator*=(const VecArray<N, T>& rhs)
+  {
+    assert(rhs.count == count);
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      const T* b = rhs.component(c);
+      for (std::size_t i = 0; i < count; i++)
+        a[i] *= b[i];
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator*=(T rhs)
+  {
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      for (std::size_t i = 0; i < count; i++)
+        a[i] *= rhs;
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator/=(const VecArray<N, T>& rhs)
+  {
+    assert(rhs.count == count);
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      const T* b = rhs.component(c);
+      for (std::size_t i = 0; i < count; i++)
+        a[i] /= b[i];
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T>& VecArray<N, T>::operator/=(T rhs)
+  {
+    for (int c = 0; c < N; c++)
+    {
+      T* a = component(c);
+      for (std::size_t i = 0; i < count; i++)
+        a[i] /= rhs;
+    }
+    return *this;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator-(const VecArray<N, T>& rhs)
+  {
+    VecArray<N, T> result(rhs);
+    result *= T(-1);
+    return result;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator+(const VecArray<N, T>& lhs, const VecArray<N, T>& rhs)
+  {
+    VecArray<N, T> result(lhs);
+    result += rhs;
+    return result;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator-(const VecArray<N, T>& lhs, const VecArray<N, T>& rhs)
+  {
+    VecArray<N, T> result(lhs);
+    result -= rhs;
+    return result;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator*(const VecArray<N, T>& lhs, const VecArray<N, T>& rhs)
+  {
+    VecArray<N, T> result(lhs);
+    result *= rhs;
+    return result;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator*(const VecArray<N, T>& lhs, T rhs)
+  {
+    VecArray<N, T> result(lhs);
+    result *= rhs;
+    return result;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator*(T lhs, const VecArray<N, T>& rhs)
+  {
+    VecArray<N, T> result(rhs);
+    result *= lhs;
+    return result;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator/(const VecArray<N, T>& lhs, const VecArray<N, T>& rhs)
+  {
+    VecArray<N, T> result(lhs);
+    result /= rhs;
+    return result;
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> operator/(const VecArray<N, T>& lhs, T rhs)
+  {
+    VecArray<N, T> result(lhs);
+    result /= rhs;
+    return result;
+  }
+
+#pragma endregion
+#pragma region "Utility Methods"
+  // result[i] = dot(lhs[i], rhs[i])
+  template<int N, typename T>
+  inline void dot(const VecArray<N, T>& lhs, const VecArray<N, T>& rhs, span<type_identity_t<T>> result)
+  {
+    assert(lhs.size() == rhs.size() && result.size() == lhs.size());
+    T* out = result.data();
+    const std::size_t n = lhs.size();
+    {
+      const T* a = lhs.component(0);
+      const T* b = rhs.component(0);
+      for (std::size_t i = 0; i < n; i++)
+        out[i] = a[i] * b[i];
+    }
+    for (int c = 1; c < N; c++)
+    {
+      const T* a = lhs.component(c);
+      const T* b = rhs.component(c);
+      for (std::size_t i = 0; i < n; i++)
+        out[i] += a[i] * b[i];
+    }
+  }
+
+  template<int N, typename T>
+  inline void length_squared(const VecArray<N, T>& rhs, span<type_identity_t<T>> result)
+  {
+    dot(rhs, rhs, result);
+  }
+
+  template<int N, typename T>
+  inline void length(const VecArray<N, T>& rhs, span<type_identity_t<T>> result)
+  {
+    length_squared(rhs, result);
+    T* out = result.data();
+    for (std::size_t i = 0; i < result.size(); i++)
+      out[i] = std::sqrt(out[i]);
+  }
+
+  template<int N, typename T>
+  inline void distance_squared(const VecArray<N, T>& lhs, const VecArray<N, T>& rhs, span<type_identity_t<T>> result)
+  {
+    assert(lhs.size() == rhs.size() && result.size() == lhs.size());
+    T* out = result.data();
+    const std::size_t n = lhs.size();
+    std::fill(out, out + n, T(0));
+    for (int c = 0; c < N; c++)
+    {
+      const T* a = lhs.component(c);
+      const T* b = rhs.component(c);
+      for (std::size_t i = 0; i < n; i++)
+      {
+        const T d = a[i] - b[i];
+        out[i] += d * d;
+      }
+    }
+  }
+
+  template<int N, typename T>
+  inline void distance(const VecArray<N, T>& lhs, const VecArray<N, T>& rhs, span<type_identity_t<T>> result)
+  {
+    distance_squared(lhs, rhs, result);
+    T* out = result.data();
+    for (std::size_t i = 0; i < result.size(); i++)
+      out[i] = std::sqrt(out[i]);
+  }
+
+  // result may be the same array as rhs
+  template<int N, typename T>
+  inline void normalize(const VecArray<N, T>& rhs, VecArray<N, T>& result)
+  {
+    const std::size_t n = rhs.size();
+    if (&result != &rhs)
+      result.resize(n);
+
+    for (std::size_t i0 = 0; i0 < n; i0 += 256)
+    {
+      // lengths of one block are kept on the stack, each loop then runs along a single stream
+      T len[256];
+      const std::size_t m = std::min<std::size_t>(256, n - i0);
+      std::fill(len, len + m, T(0));
+      for (int c = 0; c < N; c++)
+      {
+        const T* a = rhs.component(c) + i0;
+        for (std::size_t i = 0; i < m; i++)
+          len[i] += a[i] * a[i];
+      }
+      for (std::size_t i = 0; i < m; i++)
+        len[i] = std::sqrt(len[i]);
+      for (int c = 0; c < N; c++)
+      {
+        const T* a = rhs.component(c) + i0;
+        T* out = result.component(c) + i0;
+        for (std::size_t i = 0; i < m; i++)
+          out[i] = a[i] / len[i];
+      }
+    }
+  }
+
+  template<int N, typename T>
+  inline VecArray<N, T> normalize(const VecArray<N, T>& rhs)
+  {
+    VecArray<N, T> result(rhs.size());
+    normalize(rhs, result);
+    return result;
+  }
+
+  // result may be the same array as lhs or rhs
+  template<typename T>
+  inline void cross(const VecArray<3, T>& lhs, const VecArray<3, T>& rhs, VecArray<3, T>& result)
+  {
+    assert(lhs.size() == rhs.size());
+    const std::size_t n = lhs.size();
+    if (&result != &lhs && &result != &rhs)
+      result.resize(n);
+
+    const T* ax = lhs.component(0);
+    const T* ay = lhs.component(1);
+    const T* az = lhs.component(2);
+    const T* bx = rhs.component(0);
+    const T* by = rhs.component(1);
+    const T* bz = rhs.component(2);
+    T* rx = result.component(0);
+    T* ry = result.component(1);
+    T* rz = result.component(2);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      const T x = ay[i] * bz[i] - az[i] * by[i];
+      const T y = az[i] * bx[i] - ax[i] * bz[i];
+      const T z = ax[i] * by[i] - ay[i] * bx[i];
+      rx[i] = x;
+      ry[i] = y;
+      rz[i] = z;
+    }
+  }
+
+  template<typename T>
+  inline VecArray<3, T> cross(const VecArray<3, T>& lhs, const VecArray<3, T>& rhs)
+  {
+    VecArray<3, T> result(lhs.size());
+    cross(lhs, rhs, result);
+    return result;
+  }
+
+#pragma endregion
+#if defined(NDV_SIMD_SSE)
+#pragma region "VecArray SIMD Methods"
+  // overloads for float streams, four elements per step. streams are aligned, outputs may not be.
+  // the loops run over the output span, the inputs are asserted to match it
+
+  template<int N>
+  inline void dot(const VecArray<N, float>& lhs, const VecArray<N, float>& rhs, span<float> result)
+  {
+    assert(lhs.size() == rhs.size() && result.size() == lhs.size());
+    const std::size_t n = result.size();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 acc = _mm_mul_ps(_mm_load_ps(lhs.component(0) + i), _mm_load_ps(rhs.component(0) + i));
+      for (int c = 1; c < N; c++)
+        acc = simd::madd(_mm_load_ps(lhs.component(c) + i), _mm_load_ps(rhs.component(c) + i), acc);
+      _mm_storeu_ps(result.data() + i, acc);
+    }
+    for (; i < n; i++)
+      result[i] = dot(lhs[i], rhs[i]);
+  }
+
+  template<int N>
+  inline void length(const VecArray<N, float>& rhs, span<float> result)
+  {
+    assert(result.size() == rhs.size());
+    const std::size_t n = result.size();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 acc = _mm_setzero_ps();
+      for (int c = 0; c < N; c++)
+      {
+        const __m128 a = _mm_load_ps(rhs.component(c) + i);
+        acc = simd::madd(a, a, acc);
+      }
+      _mm_storeu_ps(result.data() + i, _mm_sqrt_ps(acc));
+    }
+    for (; i < n; i++)
+      result[i] = length(rhs[i]);
+  }
+
+  template<int N>
+  inline void distance(const VecArray<N, float>& lhs, const VecArray<N, float>& rhs, span<float> result)
+  {
+    assert(lhs.size() == rhs.size() && result.size() == lhs.size());
+    const std::size_t n = result.size();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 acc = _mm_setzero_ps();
+      for (int c = 0; c < N; c++)
+      {
+        const __m128 d = _mm_sub_ps(_mm_load_ps(lhs.component(c) + i), _mm_load_ps(rhs.component(c) + i));
+        acc = simd::madd(d, d, acc);
+      }
+      _mm_storeu_ps(result.data() + i, _mm_sqrt_ps(acc));
+    }
+    for (; i < n; i++)
+      result[i] = distance(lhs[i], rhs[i]);
+  }
+
+  // single pass: the squared lengths of four elements stay in a register
+  template<int N>
+  inline void normalize(const VecArray<N, float>& rhs, VecArray<N, float>& result)
+  {
+    const std::size_t n = rhs.size();
+    if (&result != &rhs)
+      result.resize(n);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+      __m128 a[N];
+      __m128 acc = _mm_setzero_ps();
+      for (int c = 0; c < N; c++)
+      {
+        a[c] = _mm_load_ps(rhs.component(c) + i);
+        acc = simd::madd(a[c], a[c], acc);
+      }
+      const __m128 len = _mm_sqrt_ps(acc);
+      for (int c = 0; c < N; c++)
+        _mm_store_ps(result.component(c) + i, _mm_div_ps(a[c], len));
+    }
+    for (; i < n; i++)
+      result[i] = normalize(rhs[i]);
+  }
+
+#pragma endregion
+#endif
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ndv/mat.h>
+#include <ndv/quat.h>
+#include <ndv/vec.h>
+
+#include <algorithm>
+#include <cmath>
+
+// tolerance comparisons for the tests. eps is absolute up to magnitude 1 and relative above, so
+// large translations are compared to the same number of digits as unit vectors
+template<typename T>
+inline bool approx(T lhs, T rhs, T eps = T(1e-5))
+{
+  return std::abs(lhs - rhs) <= eps * std::max(T(1), std::abs(rhs));
+}
+
+template<int N, typename T>
+inline bool approx_vec(const ndv::Vec<N, T>& lhs, const ndv::Vec<N, T>& rhs, T eps = T(1e-5))
+{
+  for (int i = 0; i < N; i++)
+    if (!approx(lhs[i], rhs[i], eps))
+      return false;
+  return true;
+}
+
+template<int N, int M, typename T>
+inline bool approx_mat(const ndv::Mat<N, M, T>& lhs, const ndv::Mat<N, M, T>& rhs, T eps = T(1e-5))
+{
+  for (int r = 0; r < N; r++)
+    for (int c = 0; c < M; c++)
+      if (!approx(lhs[r][c], rhs[r][c], eps))
+        return false;
+  return true;
+}
+
+inline bool approx_quat(const ndv::Quat& lhs, const ndv::Quat& rhs, float eps = 1e-5f)
+{
+  return approx(lhs.w, rhs.w, eps) && approx(lhs.x, rhs.x, eps) && approx(lhs.y, rhs.y, eps) && approx(lhs.z, rhs.z, eps);
+}
+
+// q and -q are the same rotation
+inline bool approx_rotation(const ndv::Quat& lhs, const ndv::Quat& rhs, float eps = 1e-5f)
+{
+  return std::abs(std::abs(dot(lhs, rhs)) - 1) <= eps;
+}
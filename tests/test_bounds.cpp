@@ -0,0 +1,154 @@
+#include <ndv/bounds.h>
+#include <ndv/frustum.h>
+#include <ndv/quat.h>
+using namespace ndv;
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "approx.h"
+
+// bound of the 8 transformed corners, which Arvo's method must match
+static AABB3 transform_corners(const Mat4& m, const AABB3& box)
+{
+  AABB3 result = AABB3::empty;
+  for (int k = 0; k < 8; k++)
+  {
+    const Vec3 corner((k & 1) ? box.max.x : box.min.x, (k & 2) ? box.max.y : box.min.y, (k & 4) ? box.max.z : box.min.z);
+    const Vec4 p = m * Vec4(corner.x, corner.y, corner.z, 1);
+    result = merge(result, Vec3(p.x, p.y, p.z));
+  }
+  return result;
+}
+
+static Mat4 object_matrix(int i)
+{
+  Mat4 m = to_mat4(Quat::axis_angle(Vec3(1, float(i % 3), -0.5f), 0.3f * i)) * scale(Vec3(1.0f + 0.1f * i, 0.5f, 2.0f));
+  m.row[0].w = float(i);
+  m.row[1].w = -2.0f;
+  m.row[2].w = 0.5f * i;
+  return m;
+}
+
+TEST_CASE("Bounds tests")
+{
+  const AABB3 a(Vec3(0, 0, 0), Vec3(2, 2, 2));
+  const AABB3 b(Vec3(1, -1, 1), Vec3(3, 1, 4));
+
+  SUBCASE("AABB operations")
+  {
+    CHECK(merge(a, b) == AABB3(Vec3(0, -1, 0), Vec3(3, 2, 4)));
+    CHECK(intersection(a, b) == AABB3(Vec3(1, 0, 1), Vec3(2, 1, 2)));
+    CHECK(intersects(a, b));
+    CHECK(!intersects(a, AABB3(Vec3(2.5f), Vec3(3))));
+    CHECK(is_empty(intersection(a, AABB3(Vec3(2.5f), Vec3(3)))));
+    CHECK(is_empty(AABB3::empty));
+    CHECK(merge(AABB3::empty, a) == a);
+    CHECK(contains(a, Vec3(1, 2, 0)));
+    CHECK(!contains(a, Vec3(1, 2.1f, 0)));
+    CHECK(contains(merge(a, b), b));
+    CHECK(!contains(a, b));
+    CHECK(center(b) == Vec3(2, 0, 2.5f));
+    CHECK(extents(b) == Vec3(1, 1, 1.5f));
+
+    const std::vector<Vec3> points = {Vec3(1, 5, -2), Vec3(-3, 0, 4), Vec3(2, 2, 2)};
+    CHECK(bounding_box<3, float>(points) == AABB3(Vec3(-3, 0, -2), Vec3(2, 5, 4)));
+  }
+
+  SUBCASE("Sphere operations")
+  {
+    const Sphere3 s(Vec3(0, 0, 0), 1), t(Vec3(3, 0, 0), 1);
+    const Sphere3 m = merge(s, t);
+    CHECK(approx_vec(m.center, Vec3(1.5f, 0, 0)));
+    CHECK(m.radius == doctest::Approx(2.5f));
+    CHECK(contains(m, s));
+    CHECK(contains(m, t));
+    CHECK(merge(m, s) == m);
+    CHECK(!intersects(s, t));
+    CHECK(intersects(s, Sphere3(Vec3(0, 1.5f, 0), 0.6f)));
+    CHECK(contains(s, Vec3(0, 0.9f, 0)));
+    CHECK(!contains(s, Vec3(0.8f, 0.8f, 0)));
+
+    CHECK(intersects(a, Sphere3(Vec3(3, 1, 1), 1.1f)));
+    CHECK(!intersects(a, Sphere3(Vec3(3, 3, 3), 1.5f)));
+    CHECK(bounding_box(t) == AABB3(Vec3(2, -1, -1), Vec3(4, 1, 1)));
+    CHECK(bounding_sphere(a).radius == doctest::Approx(std::sqrt(3.0f)));
+  }
+
+  SUBCASE("Transformed bounds")
+  {
+    for (int i = 0; i < 5; i++)
+    {
+      const Mat4 m = object_matrix(i);
+      const AABB3 box = transform(m, b);
+      const AABB3 corners = transform_corners(m, b);
+      CHECK(approx_vec(box.min, corners.min));
+      CHECK(approx_vec(box.max, corners.max));
+
+      // the transformed sphere holds every transformed point of the original one
+      const Sphere3 s(Vec3(1, -1, 2), 1.5f);
+      const Sphere3 ts = transform(m, s);
+      for (int k = 0; k < 26; k++)
+      {
+        const Vec3 dir = normalize(Vec3(float(k % 3) - 1, float(k / 3 % 3) - 1, float(k / 9) - 1 + 0.01f));
+        const Vec3 p = s.center + dir * s.radius;
+        const Vec4 tp = m * Vec4(p.x, p.y, p.z, 1);
+        CHECK(distance(Vec3(tp.x, tp.y, tp.z), ts.center) <= ts.radius * 1.0001f);
+      }
+    }
+  }
+
+  SUBCASE("Batched transforms")
+  {
+    // 11 objects: two groups of four for the SSE kernels and three left for the scalar loop
+    const int n = 11;
+    std::vector<Mat4> matrices;
+    std::vector<AABB3> boxes, out_boxes(n), boxes_in_place;
+    std::vector<Sphere3> spheres, out_spheres(n);
+    for (int i = 0; i < n; i++)
+    {
+      matrices.push_back(object_matrix(i));
+      boxes.emplace_back(Vec3(-float(i), 0, 1), Vec3(1, 0.5f * i, 3));
+      spheres.emplace_back(Vec3(float(i), 1, -2), 0.25f * (i + 1));
+    }
+
+    transform_bounds(matrices[3], boxes, out_boxes);
+    boxes_in_place = boxes;
+    transform_bounds(matrices, boxes_in_place, boxes_in_place);
+    for (int i = 0; i < n; i++)
+    {
+      const AABB3 one = transform(matrices[3], boxes[i]), own = transform(matrices[i], boxes[i]);
+      CHECK(approx_vec(out_boxes[i].min, one.min));
+      CHECK(approx_vec(out_boxes[i].max, one.max));
+      CHECK(approx_vec(boxes_in_place[i].min, own.min));
+      CHECK(approx_vec(boxes_in_place[i].max, own.max));
+    }
+
+    transform_bounds(matrices[3], spheres, out_spheres);
+    for (int i = 0; i < n; i++)
+    {
+      const Sphere3 s = transform(matrices[3], spheres[i]);
+      CHECK(approx_vec(out_spheres[i].center, s.center));
+      CHECK(std::abs(out_spheres[i].radius - s.radius) <= 1e-4f);
+    }
+    transform_bounds(matrices, spheres, out_spheres);
+    for (int i = 0; i < n; i++)
+    {
+      const Sphere3 s = transform(matrices[i], spheres[i]);
+      CHECK(approx_vec(out_spheres[i].center, s.center));
+      CHECK(std::abs(out_spheres[i].radius - s.radius) <= 1e-4f);
+    }
+  }
+
+  SUBCASE("Frustum tests")
+  {
+    const Frustum<float> frustum(perspective(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f));
+    CHECK(intersects(frustum, AABB3(Vec3(9.5f, -1, -12), Vec3(14.5f, 1, -8))));
+    CHECK(!intersects(frustum, AABB3(Vec3(11.1f, -1, -11), Vec3(12.9f, 1, -9))));
+    CHECK(intersects(frustum, Sphere3(Vec3(0, 0, -102), 3.0f)));
+    CHECK(!intersects(frustum, Sphere3(Vec3(0, 0, -102), 1.0f)));
+  }
+}
@@ -0,0 +1,74 @@
+#include <ndv/dual_quat.h>
+using namespace ndv;
+
+#include <cmath>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "approx.h"
+
+TEST_CASE("DualQuat tests")
+{
+  const Quat ra = Quat::axis_angle(Vec3(1, 2, -0.5f), 0.8f);
+  const Quat rb = Quat::axis_angle(Vec3(0, 1, 1), -1.3f);
+  const DualQuat a(ra, Vec3(1, -2, 3)), b(rb, Vec3(0.5f, 0, -1));
+  const Vec3 p(0.25f, -3, 1.5f);
+
+  SUBCASE("Rotation then translation")
+  {
+    CHECK(approx_vec(translation(a), Vec3(1, -2, 3)));
+    CHECK(approx_vec(transform_point(a, p), rotate(p, ra) + Vec3(1, -2, 3)));
+    CHECK(approx_vec(transform_direction(a, p), rotate(p, ra)));
+    CHECK(transform_point(DualQuat::identity, p) == p);
+  }
+
+  SUBCASE("Composition and inverse")
+  {
+    CHECK(approx_vec(transform_point(a * b, p), transform_point(a, transform_point(b, p))));
+    CHECK(approx_vec(transform_point(inverse(a), transform_point(a, p)), p));
+    DualQuat c = a;
+    c *= b;
+    CHECK(c == a * b);
+  }
+
+  SUBCASE("Matrix conversion")
+  {
+    const Mat4 m = to_mat4(a);
+    const Vec4 q = m * Vec4(p.x, p.y, p.z, 1);
+    CHECK(approx_vec(Vec3(q.x, q.y, q.z), transform_point(a, p)));
+
+    const DualQuat back(m);
+    CHECK(approx_vec(transform_point(back, p), transform_point(a, p), 1e-4f));
+    CHECK(approx_vec(translation(DualQuat(translate(Vec3(4, 5, 6)))), Vec3(4, 5, 6)));
+  }
+
+  SUBCASE("Linear blending")
+  {
+    // the endpoints, and a blend that stays rigid and follows the shorter path
+    CHECK(approx_vec(transform_point(blend(a, b, 0), p), transform_point(a, p)));
+    CHECK(approx_vec(transform_point(blend(a, -b, 1), p), transform_point(b, p), 1e-4f));
+
+    const DualQuat half = blend(a, b, 0.5f);
+    CHECK(length(half.real) == doctest::Approx(1.0f));
+    CHECK(dot(half.real, half.dual) == doctest::Approx(0.0f).epsilon(1e-6));
+    CHECK(approx_vec(transform_point(half, p), transform_point(blend(a, -b, 0.5f), p), 1e-5f));
+
+    const std::vector<DualQuat> dqs = {a, -b, a};
+    const std::vector<float> weights = {0.25f, 0.5f, 0.25f};
+    CHECK(approx_vec(transform_point(blend(dqs, weights), p), transform_point(half, p), 1e-5f));
+
+    // pure translations blend linearly
+    const DualQuat t = blend(DualQuat(Quat::identity, Vec3(0, 0, 0)), DualQuat(Quat::identity, Vec3(2, 4, 0)), 0.25f);
+    CHECK(approx_vec(translation(t), Vec3(0.5f, 1, 0)));
+  }
+}
+
+TEST_CASE("DualQuat constexpr tests")
+{
+  constexpr DualQuat t(Quat::identity, Vec3(1, 2, 3));
+  static_assert(translation(t) == Vec3(1, 2, 3));
+  static_assert(transform_point(t * t, Vec3(0, 0, 0)) == Vec3(2, 4, 6));
+  static_assert(inverse(t) * t == DualQuat::identity);
+  CHECK(t.real == Quat::identity);
+}
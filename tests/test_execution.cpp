@@ -0,0 +1,64 @@
+#include <ndv/execution.h>
+#include <ndv/transform.h>
+using namespace ndv;
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("Execution tests")
+{
+  ThreadPool pool(3);
+
+  SUBCASE("Thread pool")
+  {
+    CHECK(pool.size() == 3);
+
+    // every index exactly once, also from bulk calls nested in tasks
+    std::vector<std::atomic<int>> calls(1000);
+    pool.bulk(10, [&](std::size_t i) {
+      pool.bulk(100, [&](std::size_t j) { calls[i * 100 + j].fetch_add(1); });
+    });
+    for (const std::atomic<int>& c : calls)
+      CHECK(c.load() == 1);
+
+    CHECK_THROWS_AS(pool.bulk(50, [](std::size_t i) {
+      if (i == 17)
+        throw std::runtime_error("task failed");
+    }), std::runtime_error);
+
+    // the caller alone without workers
+    ThreadPool inline_pool(0);
+    int sum = 0;
+    inline_pool.bulk(5, [&](std::size_t i) { sum += int(i); });
+    CHECK(sum == 10);
+  }
+
+  SUBCASE("Batch kernels under policies")
+  {
+    // a few blocks and a ragged last one
+    const std::size_t n = 3 * detail::block_size(2 * sizeof(Vec3)) + 7;
+    std::vector<Vec3> points(n), expected(n), out(n);
+    for (std::size_t i = 0; i < n; i++)
+      points[i] = Vec3(std::sin(0.1f * i), 2.0f + std::cos(0.3f * i), 0.01f * i);
+
+    Mat4 m = translate(Vec3(1, 2, 3));
+    m[0][1] = 0.5f;
+    transform_points(m, points, expected);
+    transform_points(par.on(pool), m, points, out);
+    CHECK(out == expected);
+    transform_points(seq, m, points, out);
+    CHECK(out == expected);
+    transform_points(par, m, points, out);
+    CHECK(out == expected);
+
+    normalize(points, expected);
+    out = points;
+    normalize(par.on(pool), out, out);
+    CHECK(out == expected);
+    CHECK(length(out[n - 1]) == doctest::Approx(1.0f));
+  }
+}
@@ -0,0 +1,60 @@
+#include <ndv/expr.h>
+using namespace ndv;
+
+#include <type_traits>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("Expression template tests")
+{
+  using Vec8 = Vec<8, float>;
+  Vec8 a, b, c;
+  for (int i = 0; i < 8; i++)
+  {
+    a[i] = float(i);
+    b[i] = float(2 * i + 1);
+    c[i] = float(8 - i);
+  }
+
+  SUBCASE("Matches eager operators")
+  {
+    Vec8 r = lazy(a) + lazy(b) * 2.0f - c;
+    CHECK(r == a + b * 2.0f - c);
+
+    Vec8 q = -(lazy(a) - b) / 4.0f + 3.0f * lazy(c);
+    CHECK(q == -(a - b) / 4.0f + 3.0f * c);
+
+    CHECK(eval(lazy(a) * b / c) == a * b / c);
+  }
+
+  SUBCASE("Assign may alias an operand")
+  {
+    Vec8 expected = a + b * 0.5f;
+    assign(a, a + lazy(b) * 0.5f);
+    CHECK(a == expected);
+  }
+
+  SUBCASE("Small Vecs stay eager")
+  {
+    Vec3 v(1, 2, 3);
+    static_assert(std::is_same_v<decltype(lazy(v) + v), Vec3>);
+    CHECK(lazy(v) * 2.0f == Vec3(2, 4, 6));
+  }
+
+  SUBCASE("Mat sums")
+  {
+    using Mat6d = Mat<6, 6, double>;
+    Mat6d m = Mat6d::diag(2);
+    Mat6d n = Mat6d::full(1);
+    Mat6d s = lazy(m) * 0.5 + n - lazy(n) * 2.0;
+    CHECK(s == m * 0.5 + n - n * 2.0);
+    static_assert(std::is_same_v<decltype(lazy(Mat4::identity)), const Mat4&>);
+  }
+}
+
+TEST_CASE("Expression template constexpr tests")
+{
+  constexpr Vec<6, int> a{1, 2, 3, 4, 5, 6};
+  constexpr Vec<6, int> b = lazy(a) * 2 - a;
+  static_assert(b == a);
+}
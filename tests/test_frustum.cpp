@@ -0,0 +1,84 @@
+#include <ndv/frustum.h>
+using namespace ndv;
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+TEST_CASE("Frustum tests")
+{
+  // a 90 degree frustum looking down -z, from z = -1 to z = -100
+  const Frustum<float> frustum(perspective(-1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 100.0f));
+
+  SUBCASE("Plane extraction")
+  {
+    CHECK(contains(frustum, Vec3(0, 0, -10)));
+    CHECK(!contains(frustum, Vec3(0, 0, 10)));
+    CHECK(!contains(frustum, Vec3(0, 0, -0.5f)));
+    CHECK(!contains(frustum, Vec3(0, 0, -101)));
+    CHECK(!contains(frustum, Vec3(11, 0, -10)));
+    CHECK(contains(frustum, Vec3(9, -9, -10)));
+
+    // unit normals, so plane values are distances
+    CHECK(signed_distance(frustum.planes[5], Vec3(0, 0, -90)) == doctest::Approx(10.0f));
+    CHECK(intersects_sphere(frustum, Vec3(0, 0, -102), 3.0f));
+    CHECK(!intersects_sphere(frustum, Vec3(0, 0, -102), 1.0f));
+    CHECK(intersects_box(frustum, Vec3(12, 0, -10), Vec3(2.5f)));
+    CHECK(!intersects_box(frustum, Vec3(12, 0, -10), Vec3(0.9f)));
+
+    const Frustum<float> ortho(orthographic(-2.0f, 2.0f, 2.0f, -2.0f, 0.5f, 10.0f));
+    CHECK(contains(ortho, Vec3(1.9f, -1.9f, -5)));
+    CHECK(!contains(ortho, Vec3(2.1f, 0, -5)));
+  }
+
+  SUBCASE("Batched culling")
+  {
+    // 1007 = 125 * 8 + 4 + 3 objects: paired four-object blocks, one single block, then a tail
+    const std::size_t n = 1007;
+    VecArray<3, float> centers(n), extents(n);
+    std::vector<float> radii(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      centers[i] = Vec3(30 * std::sin(0.37f * i), 30 * std::cos(0.11f * i), -60 * std::abs(std::sin(0.05f * i)) + 5);
+      extents[i] = Vec3(0.5f + (i % 3), 1.0f, 0.25f * (i % 5));
+      radii[i] = 0.5f + float(i % 7);
+    }
+
+    std::vector<std::uint64_t> mask((n + 63) / 64, ~std::uint64_t(0));
+    std::vector<std::uint32_t> indices(n);
+    const std::size_t spheres = cull_spheres(frustum, centers, radii, mask);
+    CHECK(cull_spheres(frustum, centers, radii, indices) == spheres);
+
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      const bool visible = intersects_sphere(frustum, centers[i], radii[i]);
+      CHECK(visible == bool((mask[i / 64] >> (i % 64)) & 1));
+      if (visible)
+      {
+        REQUIRE(next < spheres);
+        CHECK(indices[next++] == i);
+      }
+    }
+    CHECK(next == spheres);
+    CHECK(spheres > 0);
+    CHECK(spheres < n);
+
+    const std::size_t boxes = cull_boxes(frustum, centers, extents, mask);
+    CHECK(cull_boxes(frustum, centers, extents, indices) == boxes);
+    next = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+      const bool visible = intersects_box(frustum, centers[i], extents[i]);
+      CHECK(visible == bool((mask[i / 64] >> (i % 64)) & 1));
+      if (visible)
+      {
+        REQUIRE(next < boxes);
+        CHECK(indices[next++] == i);
+      }
+    }
+    CHECK(next == boxes);
+  }
+}
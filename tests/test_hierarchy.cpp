@@ -0,0 +1,79 @@
+#include <ndv/hierarchy.h>
+using namespace ndv;
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "approx.h"
+
+// world matrices walked up to the root for every node, the slow way
+static void check_reference(const TransformHierarchy& hierarchy)
+{
+  for (std::uint32_t i = 0; i < hierarchy.size(); i++)
+  {
+    Mat4 world = hierarchy.local(i);
+    for (std::uint32_t p = hierarchy.parent(i); p != TransformHierarchy::no_parent; p = hierarchy.parent(p))
+      world = hierarchy.local(p) * world;
+    for (int r = 0; r < 4; r++)
+      for (int c = 0; c < 4; c++)
+        CHECK(hierarchy.world(i)[r][c] == doctest::Approx(world[r][c]).epsilon(1e-4));
+  }
+}
+
+static Mat4 node_local(std::uint32_t i, float t)
+{
+  return translate(Vec3(0.1f * (i % 7), 0.2f, -0.05f * (i % 3))) * rotate(Vec3(0.0f, 1.0f, 0.5f), 0.05f * i + t);
+}
+
+TEST_CASE("TransformHierarchy tests")
+{
+  // two roots with a mix of deep chains and wide fans, enough nodes per depth for several blocks
+  TransformHierarchy hierarchy;
+  const std::uint32_t roots[2] = {hierarchy.add(TransformHierarchy::no_parent, node_local(0, 0)), hierarchy.add(TransformHierarchy::no_parent, node_local(1, 0))};
+  for (std::uint32_t i = 2; i < 3000; i++)
+  {
+    std::uint32_t parent = i - 1 - (i * 7919u) % std::min(i - 1, 16u);
+    if (i % 5 == 0)
+      parent = roots[i % 2];
+    else if (i % 3 == 0)
+      parent = i / 2;
+    hierarchy.add(parent, node_local(i, 0));
+  }
+
+  SUBCASE("Full and dirty updates")
+  {
+    CHECK(hierarchy.update() == hierarchy.size());
+    check_reference(hierarchy);
+    CHECK(hierarchy.update() == 0);
+
+    // a leaf-ish node and a root: the root's whole subtree is recomputed, nothing else
+    hierarchy.set_local(2999, node_local(2999, 1.0f));
+    CHECK(hierarchy.update() == 1);
+    hierarchy.set_local(roots[1], node_local(1, 0.5f));
+    const std::size_t recomputed = hierarchy.update();
+    CHECK(recomputed > 1);
+    CHECK(recomputed < hierarchy.size());
+    check_reference(hierarchy);
+    CHECK(hierarchy.world().size() == hierarchy.size());
+    CHECK(hierarchy.world().data() == &hierarchy.world(0));
+  }
+
+  SUBCASE("Parallel updates")
+  {
+    ThreadPool pool(3);
+    CHECK(hierarchy.update(par.on(pool)) == hierarchy.size());
+    check_reference(hierarchy);
+
+    for (std::uint32_t i = 10; i < hierarchy.size(); i += 97)
+      hierarchy.set_local(i, node_local(i, 2.0f));
+    const std::uint32_t added = hierarchy.add(17, node_local(3000, 0));
+    hierarchy.update(par.on(pool));
+    check_reference(hierarchy);
+    CHECK(approx_mat(hierarchy.world(added), hierarchy.world(17) * node_local(3000, 0)));
+    CHECK(hierarchy.update(seq) == 0);
+  }
+}
@@ -1,8 +1,12 @@
 #include <ndv/mat.h>
 using namespace ndv;
 
+#include <cmath>
+
 #include <doctest/doctest.h>
 
+#include "approx.h"
+
 TEST_CASE("Mat template class tests")
 {
   Mat4 m = Mat4::diag(2);
@@ -12,3 +16,218 @@ TEST_CASE("Mat template class tests")
     CHECK(m[0][0] == 2);
   }
 }
+
+TEST_CASE("Mat4 product tests")
+{
+  Mat4 a({
+    {1, 2, 3, 4},
+    {5, 6, 7, 8},
+    {9, 10, 11, 12},
+    {13, 14, 15, 16}
+  });
+  Mat4 b({
+    {2, 0, 0, 1},
+    {0, 1, 0, 2},
+    {1, 0, 1, 0},
+    {0, 3, 0, 1}
+  });
+  Mat4 ab({
+    {5, 14, 3, 9},
+    {17, 30, 7, 25},
+    {29, 46, 11, 41},
+    {41, 62, 15, 57}
+  });
+
+  SUBCASE("Matrix product")
+  {
+    CHECK(a * b == ab);
+    CHECK(a * Mat4::identity == a);
+    CHECK(Mat4::identity * b == b);
+  }
+
+  SUBCASE("In-place product")
+  {
+    Mat4 c = a;
+    c *= b;
+    CHECK(c == ab);
+
+    Mat4 d = b;
+    d *= d;
+    CHECK(d == b * b);
+  }
+
+  SUBCASE("Matrix-vector product")
+  {
+    Vec4 v(1, 0, -1, 2);
+    CHECK(a * v == Vec4(6, 14, 22, 30));
+    CHECK(Mat4::identity * v == v);
+  }
+}
+
+TEST_CASE("Mat4 determinant and inverse tests")
+{
+  Mat4 m({
+    {2, 1, 0, 3},
+    {0, 1, 4, 1},
+    {1, 0, 2, 0},
+    {3, 2, 1, 2}
+  });
+
+  SUBCASE("Determinant")
+  {
+    CHECK(determinant(m) == doctest::Approx(-26));
+    CHECK(determinant(Mat4::identity) == 1);
+    CHECK(determinant(Mat4d({{2, 1, 0, 3}, {0, 1, 4, 1}, {1, 0, 2, 0}, {3, 2, 1, 2}})) == doctest::Approx(-26));
+  }
+
+  SUBCASE("General inverse")
+  {
+    Mat4 inv = inverse(m);
+    CHECK(approx_mat(inv * m, Mat4::identity));
+    CHECK(approx_mat(m * inv, Mat4::identity));
+    CHECK(inverse(Mat4::zero) == Mat4::zero);
+
+    Mat4d md({{2, 1, 0, 3}, {0, 1, 4, 1}, {1, 0, 2, 0}, {3, 2, 1, 2}});
+    CHECK(approx_mat(inverse(md) * md, Mat4d::identity));
+  }
+
+  SUBCASE("Affine inverse")
+  {
+    Mat4 a = translate(Vec3(1, -2, 3)) * rotate(Vec3(1, 1, 0), 0.5f);
+    a[0][0] *= 2;
+    REQUIRE(check_affine(a));
+    CHECK(approx_mat(inverse_affine(a) * a, Mat4::identity));
+    CHECK(approx_mat(inverse(a), inverse_affine(a)));
+
+    Mat4 rigid = translate(Vec3(1, -2, 3)) * rotate(Vec3(0, 0, 1), 1.0f);
+    CHECK(approx_mat(inverse_rigid(rigid) * rigid, Mat4::identity));
+  }
+}
+
+TEST_CASE("LU decomposition tests")
+{
+  using Mat6d = Mat<6, 6, double>;
+  using Vec6d = Vec<6, double>;
+
+  // zero leading entry forces a row exchange on the first pivot
+  Mat6d m;
+  for (int r = 0; r < 6; r++)
+    for (int c = 0; c < 6; c++)
+      m[r][c] = (r == c ? 7.0 : 0.0) + std::sin(1.0 + r * 6 + c);
+  m[0][0] = 0;
+
+  SUBCASE("Determinant")
+  {
+    LU<6, double> lu;
+    REQUIRE(lu_decompose(m, lu));
+    CHECK(lu.perm[0] != 0);
+    CHECK(determinant(m) == doctest::Approx(determinant_laplace(m)));
+
+    Mat<5, 5, int> mi;
+    for (int r = 0; r < 5; r++)
+      for (int c = 0; c < 5; c++)
+        mi[r][c] = (r * 3 + c * 7) % 5 + (r == c ? 2 : 0);
+    CHECK(determinant(mi) == determinant_laplace(mi));
+  }
+
+  SUBCASE("Inverse and solve")
+  {
+    CHECK(approx_mat(inverse(m) * m, Mat6d::identity, 1e-12));
+
+    Vec6d b;
+    for (int i = 0; i < 6; i++)
+      b[i] = i - 2.5;
+    const Vec6d x = solve(m, b);
+    const Vec6d mx = m * x;
+    for (int i = 0; i < 6; i++)
+      CHECK(mx[i] == doctest::Approx(b[i]));
+  }
+
+  SUBCASE("Singular")
+  {
+    Mat6d s = m;
+    for (int c = 0; c < 6; c++)
+      s[5][c] = s[1][c] - 2 * s[3][c];
+
+    LU<6, double> lu;
+    CHECK_FALSE(lu_decompose(s, lu));
+    CHECK(lu.singular);
+    CHECK(determinant(s) == 0);
+    CHECK(inverse(s) == Mat6d::zero);
+
+    const Vec6d x = solve(s, Vec6d(1.0));
+    for (int i = 0; i < 6; i++)
+      CHECK(x[i] == 0);
+  }
+}
+
+TEST_CASE("Mat constexpr tests")
+{
+  constexpr Mat4 model = translate(Vec3(1, 2, 3)) * scale(Vec3(2, 2, 2));
+  static_assert(model[0][0] == 2 && model[0][3] == 1 && model[2][3] == 3);
+  static_assert(model * Vec4(1, 1, 1, 1) == Vec4(3, 4, 5, 1));
+  static_assert(determinant(model) == 8);
+  static_assert(inverse(model) * model == Mat4::identity);
+
+  static_assert(Mat3::identity[1][1] == 1 && Mat3::identity[1][0] == 0);
+  static_assert(Mat2::zero == Mat2::full(0));
+  static_assert(orthographic(4.0f, 2.0f, 1.0f, 3.0f)[0][0] == 0.5f);
+  static_assert(determinant(Mat<5, 5, double>::diag(2)) == 32);
+
+  CHECK(model[1][3] == 2);
+}
+
+TEST_CASE("Non-square Mat tests")
+{
+  const Mat<2, 3, int> a({
+    {1, 2, 3},
+    {4, 5, 6}
+  });
+  const Mat<3, 2, int> at = transpose(a);
+
+  CHECK(a[1] == Vec3i(4, 5, 6));
+  CHECK(at[2] == Vec2i(3, 6));
+  CHECK(transpose(at) == a);
+  CHECK(a * at == Mat2i({{14, 32}, {32, 77}}));
+  CHECK(a * Vec3i(1, 0, -1) == Vec2i(-2, -2));
+}
+
+TEST_CASE("Affine3 tests")
+{
+  const Mat4 a = translate(Vec3(1, -2, 3)) * rotate(Vec3(1, 1, 0), 0.5f) * scale(Vec3(2, 1, 0.5f));
+  const Mat4 b = translate(Vec3(-4, 0, 1)) * rotate(Vec3(0, 1, 2), -1.2f);
+  const Affine3 fa = to_affine(a), fb = to_affine(b);
+
+  SUBCASE("Conversion and composition")
+  {
+    CHECK(to_mat4(fa) == a);
+    CHECK(to_mat4(Affine3::identity) == Mat4::identity);
+    CHECK(approx_mat(to_mat4(fa * fb), a * b));
+    CHECK(approx_mat(to_mat4(fa * Affine3::identity), a));
+  }
+
+  SUBCASE("Point and direction transforms")
+  {
+    const Vec3 v(0.5f, -1, 2);
+    const Vec4 p = a * Vec4(v.x, v.y, v.z, 1), d = a * Vec4(v.x, v.y, v.z, 0);
+    const Vec3 fp = transform_point(fa, v), fd = transform_direction(fa, v);
+    CHECK(fp.x == doctest::Approx(p.x));
+    CHECK(fp.y == doctest::Approx(p.y));
+    CHECK(fp.z == doctest::Approx(p.z));
+    CHECK(fd.x == doctest::Approx(d.x));
+    CHECK(fd.y == doctest::Approx(d.y));
+    CHECK(fd.z == doctest::Approx(d.z));
+  }
+
+  SUBCASE("Inverse")
+  {
+    CHECK(approx_mat(to_mat4(inverse(fa) * fa), Mat4::identity));
+    CHECK(approx_mat(to_mat4(inverse(fa)), inverse_affine(a)));
+    CHECK(approx_mat(to_mat4(inverse_rigid(fb) * fb), Mat4::identity));
+    CHECK(inverse(Affine3::zero) == Affine3::zero);
+  }
+
+  constexpr Affine3 c = to_affine(translate(Vec3(1, 2, 3)) * scale(Vec3(2, 2, 2)));
+  static_assert(c * c == to_affine(translate(Vec3(3, 6, 9)) * scale(Vec3(4, 4, 4))));
+  static_assert(transform_point(c, Vec3(1, 1, 1)) == Vec3(3, 4, 5));
+}
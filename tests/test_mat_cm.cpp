@@ -0,0 +1,77 @@
+#include <ndv/mat_cm.h>
+using namespace ndv;
+
+#include <cmath>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "approx.h"
+
+TEST_CASE("MatCM tests")
+{
+  const Mat4 a = translate(Vec3(1, -2, 3)) * rotate(Vec3(1, 1, 0), 0.5f);
+  const Mat4 p = perspective(1.0f, 1.5f, 0.1f, 100.0f);
+  const Mat4CM ca = col_major(a), cp = col_major(p);
+
+  SUBCASE("Storage")
+  {
+    // the translation is the last column, contiguous in memory
+    const float* data = &ca.cols.data[0][0];
+    CHECK(data[12] == 1);
+    CHECK(data[13] == -2);
+    CHECK(data[14] == 3);
+    CHECK(ca(0, 3) == a[0][3]);
+    CHECK(ca[3] == Vec4(1, -2, 3, 1));
+    CHECK(row_major(ca) == a);
+    CHECK(Mat4CM::identity == col_major(Mat4::identity));
+  }
+
+  SUBCASE("Operations")
+  {
+    const Vec4 v(0.5f, -1, 2, 1);
+    CHECK(approx_mat(row_major(cp * ca), p * a));
+    CHECK(row_major(ca + cp) == a + p);
+    CHECK(row_major(ca * 2.0f) == a * 2.0f);
+    CHECK(row_major(transpose(ca)) == transpose(a));
+    CHECK(check_affine(ca));
+    CHECK(!check_affine(cp));
+    CHECK(determinant(cp) == doctest::Approx(determinant(p)));
+    CHECK(approx_mat(row_major(inverse(ca)), inverse(a)));
+    CHECK(approx_mat(row_major(inverse(cp)), inverse(p)));
+
+    const Vec4 r = cp * v, e = p * v;
+    CHECK(r.x == doctest::Approx(e.x));
+    CHECK(r.y == doctest::Approx(e.y));
+    CHECK(r.z == doctest::Approx(e.z));
+    CHECK(r.w == doctest::Approx(e.w));
+
+    Mat4CM c = cp;
+    c *= ca;
+    CHECK(c == cp * ca);
+  }
+
+  SUBCASE("Bulk conversion")
+  {
+    std::vector<Mat4> in, back(7);
+    std::vector<Mat4CM> out(7);
+    for (int i = 0; i < 7; i++)
+      in.push_back(translate(Vec3(float(i), 2, -1)) * rotate(Vec3(0, 1, float(i)), 0.3f * i));
+
+    col_major(in, out);
+    row_major(out, back);
+    for (int i = 0; i < 7; i++)
+    {
+      CHECK(out[i] == col_major(in[i]));
+      CHECK(back[i] == in[i]);
+    }
+
+    col_major(seq, in, out);
+    for (int i = 0; i < 7; i++)
+      CHECK(out[i] == col_major(in[i]));
+  }
+
+  constexpr Mat4CM t = col_major(translate(Vec3(1, 2, 3)));
+  static_assert(t * Vec4(1, 1, 1, 1) == Vec4(2, 3, 4, 1));
+  static_assert(row_major(t * t) == translate(Vec3(2, 4, 6)));
+}
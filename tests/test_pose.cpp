@@ -0,0 +1,61 @@
+#include <ndv/pose.h>
+using namespace ndv;
+
+#include <doctest/doctest.h>
+
+#include "approx.h"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Pose blending tests")
+{
+  // 7 bones, so both the four-wide blocks and the tail run; odd bones are flipped to -q, which is
+  // the same rotation and has to be blended along the shorter path
+  std::vector<Quat> a, b;
+  for (int i = 0; i < 7; i++)
+  {
+    a.push_back(Quat::axis_angle(Vec3(1.0f, float(i), 0.5f), 0.3f * i));
+    const Quat q = Quat::axis_angle(Vec3(-0.5f, 1.0f, float(i)), 0.2f + 0.35f * i);
+    b.push_back((i % 2) ? -q : q);
+  }
+  std::vector<Quat> out(a.size());
+
+  SUBCASE("nlerp")
+  {
+    blend_poses(a, b, 0.3f, out);
+    for (std::size_t i = 0; i < a.size(); i++)
+      CHECK(approx_quat(out[i], nlerp(a[i], b[i], 0.3f)));
+  }
+
+  SUBCASE("slerp")
+  {
+    blend_poses(a, b, 0.3f, out, PoseBlend::slerp);
+    for (std::size_t i = 0; i < a.size(); i++)
+      CHECK(approx_quat(out[i], slerp(a[i], b[i], 0.3f)));
+  }
+
+  SUBCASE("Per-bone weights")
+  {
+    const std::vector<float> weights = {0.0f, 0.1f, 0.5f, 1.0f, 0.25f, 0.75f, 0.9f};
+    blend_poses(a, b, weights, out, PoseBlend::slerp);
+    for (std::size_t i = 0; i < a.size(); i++)
+      CHECK(approx_quat(out[i], slerp(a[i], b[i], weights[i])));
+  }
+
+  SUBCASE("Layers")
+  {
+    std::vector<Quat> additive(a.size());
+    for (std::size_t i = 0; i < a.size(); i++)
+      additive[i] = Quat::axis_angle(Vec3(0, 0, 1), 0.1f * i);
+
+    const PoseLayer layers[] = {{a, 0.7f}, {b, 0.3f}, {additive, 0.5f, true}};
+    blend_layers(layers, out);
+    for (std::size_t i = 0; i < a.size(); i++)
+      CHECK(approx_quat(out[i], nlerp(a[i], b[i], 0.3f) * nlerp(Quat::identity, additive[i], 0.5f)));
+
+    add_pose(a, additive, 1.0f, out);
+    for (std::size_t i = 0; i < a.size(); i++)
+      CHECK(approx_quat(out[i], a[i] * additive[i]));
+  }
+}
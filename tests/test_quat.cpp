@@ -1,8 +1,14 @@
 #include <ndv/quat.h>
 using namespace ndv;
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <doctest/doctest.h>
 
+#include "approx.h"
+
 TEST_CASE("Mat template class tests")
 {
   Quat q = Quat::identity;
@@ -13,3 +19,149 @@ TEST_CASE("Mat template class tests")
     CHECK(q[1] == 0);
   }
 }
+
+TEST_CASE("Quat product and rotation tests")
+{
+  const Quat i(0, 1, 0, 0), j(0, 0, 1, 0), k(0, 0, 0, 1);
+
+  SUBCASE("Hamilton product")
+  {
+    CHECK(i * j == k);
+    CHECK(j * i == -k);
+    CHECK(i * i == Quat(-1, 0, 0, 0));
+    Quat q = i;
+    q *= j;
+    CHECK(q == k);
+    CHECK(k - k == Quat(0));
+  }
+
+  SUBCASE("Inverse")
+  {
+    const Quat q(2, 0, 0, 0);
+    CHECK(q * inverse(q) == Quat::identity);
+  }
+
+  SUBCASE("Rotate matches the sandwich product")
+  {
+    const Quat q = Quat::axis_angle(Vec3(1, 2, -0.5f), 0.8f);
+    const Vec3 v(0.25f, -3, 1.5f);
+    const Quat p = q * Quat(v) * conjugate(q);
+    CHECK(approx_vec(rotate(v, q), Vec3(p.x, p.y, p.z)));
+    CHECK(approx_vec(rotate(Vec3::unit_x, Quat::axis_angle(Vec3::unit_z, 1.5707963f)), Vec3::unit_y));
+  }
+}
+
+TEST_CASE("Quat matrix conversion tests")
+{
+  SUBCASE("Matrix rotates like the quaternion")
+  {
+    const Quat q = Quat::axis_angle(Vec3(1, 2, -0.5f), 0.8f);
+    const Vec3 v(0.25f, -3, 1.5f);
+    CHECK(approx_vec(to_mat3(q) * v, rotate(v, q)));
+    const Vec4 r = to_mat4(q) * Vec4(v.x, v.y, v.z, 1);
+    CHECK(approx_vec(Vec3(r.x, r.y, r.z), rotate(v, q)));
+    CHECK(r.w == 1);
+  }
+
+  SUBCASE("Round trip through every Shepperd branch")
+  {
+    // small angle (trace largest) and near half turns about each axis (one diagonal largest)
+    const Quat quats[] = {
+      Quat::axis_angle(Vec3(1, 2, 3), 0.3f),
+      Quat::axis_angle(Vec3(1, 0.1f, 0.2f), 3.0f),
+      Quat::axis_angle(Vec3(0.1f, 1, -0.2f), 3.0f),
+      Quat::axis_angle(Vec3(0.2f, -0.1f, 1), 3.1f),
+      Quat::identity
+    };
+    for (const Quat& q : quats)
+    {
+      CHECK(std::abs(dot(from_matrix(to_mat3(q)), q)) == doctest::Approx(1.0f).epsilon(1e-5));
+      CHECK(std::abs(dot(from_matrix(to_mat4(q)), q)) == doctest::Approx(1.0f).epsilon(1e-5));
+    }
+  }
+}
+
+TEST_CASE("SlerpInterpolator tests")
+{
+  const Quat a = Quat::axis_angle(Vec3(1, 2, 3), 0.4f);
+  const Quat b = Quat::axis_angle(Vec3(-1, 0.5f, 2), 2.2f);
+  const SlerpInterpolator lerp(a, b);
+
+  SUBCASE("Matches slerp")
+  {
+    for (float t : {0.0f, 0.1f, 0.5f, 0.77f, 1.0f})
+      CHECK(approx_quat(lerp(t), slerp(a, b, t)));
+    CHECK(approx_quat(SlerpInterpolator(a, -b)(0.3f), slerp(a, b, 0.3f)));
+  }
+
+  SUBCASE("Stepping stays on the curve")
+  {
+    std::vector<Quat> samples(1000);
+    lerp.sample(samples);
+    for (std::size_t k = 0; k < samples.size(); k++)
+      CHECK(approx_quat(samples[k], slerp(a, b, float(k) / 999.0f)));
+
+    std::vector<Quat> part(5);
+    lerp.sample(part, 0.25f, 0.75f);
+    CHECK(approx_quat(part[2], lerp(0.5f)));
+  }
+
+  SUBCASE("Coincident endpoints")
+  {
+    const SlerpInterpolator same(a, a);
+    CHECK(same.linear);
+    CHECK(approx_quat(same(0.4f), a));
+  }
+}
+
+// largest component error of a decoded track, up to the sign of each quaternion
+template<typename Packed>
+static float packed_error(const std::vector<Quat>& track)
+{
+  std::vector<Packed> packed(track.size());
+  std::vector<Quat> bulk(track.size());
+  pack(track, packed);
+  unpack(packed, bulk);
+
+  float error = 0;
+  for (std::size_t i = 0; i < track.size(); i++)
+  {
+    const Quat single = packed[i].unpack();
+    const Quat q = dot(track[i], bulk[i]) < 0 ? -track[i] : track[i];
+    for (int c = 0; c < 4; c++)
+      error = std::max({error, std::abs(bulk[i][c] - q[c]), std::abs(single[c] - bulk[i][c])});
+  }
+  return error;
+}
+
+TEST_CASE("Packed quat tests")
+{
+  // every component takes a turn as the largest, with either sign. 23 is odd on purpose, the
+  // four-wide unpack also has to finish with single quaternions
+  std::vector<Quat> track = {Quat::identity, Quat(0, 1, 0, 0), Quat(0, 0, -1, 0), Quat(0, 0, 0, 1), Quat(-1, 0, 0, 0)};
+  for (int i = 0; i < 18; i++)
+    track.push_back(Quat::axis_angle(Vec3(std::sin(1.3f * i), std::cos(0.7f * i), 0.5f - 0.1f * i), 0.4f * i - 3.0f));
+
+  CHECK(packed_error<PackedQuat32>(track) < 2e-3f);
+  CHECK(packed_error<PackedQuat48>(track) < 5e-5f);
+  CHECK(packed_error<PackedQuat64>(track) < 2e-6f);
+  CHECK(packed_error<PackedQuatS16>(track) < 5e-5f);
+
+  // the dropped component is rebuilt positive
+  const Quat q = PackedQuat32(Quat(-1, 0, 0, 0)).unpack();
+  CHECK(q.w == doctest::Approx(1.0f));
+  CHECK(approx_vec(rotate(Vec3(1, 2, 3), PackedQuat48(track[9]).unpack()), rotate(Vec3(1, 2, 3), track[9]), 1e-3f));
+}
+
+TEST_CASE("Quat constexpr tests")
+{
+  constexpr Quat q(0.5f, 0.5f, -0.5f, 0.5f);
+  static_assert(Quat::identity == Quat(1, 0, 0, 0));
+  static_assert(length_squared(q) == 1);
+  static_assert(conjugate(conjugate(q)) == q && dot(q, conjugate(q)) == -0.5f);
+  static_assert(Quat(2, Vec3(1, 2, 3))[3] == 3);
+  static_assert(rotate(Vec3(1, 0, 0), Quat(0, 0, 0, 1)) == Vec3(-1, 0, 0));
+  static_assert(to_mat3(Quat::identity) == Mat3::identity && to_mat4(Quat::identity) == Mat4::identity);
+
+  CHECK(q[2] == -0.5f);
+}
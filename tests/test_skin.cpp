@@ -0,0 +1,76 @@
+#include <ndv/execution.h>
+#include <ndv/skin.h>
+using namespace ndv;
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "approx.h"
+
+TEST_CASE("Skinning tests")
+{
+  ThreadPool pool(3);
+  std::vector<Mat4> palette;
+  for (int j = 0; j < 6; j++)
+    palette.push_back(translate(Vec3(float(j), 1.0f - j, 0.5f * j)) * rotate(Vec3(1.0f, float(j), 2.0f), 0.3f * j) * scale(Vec3(1.0f + 0.1f * j)));
+
+  SUBCASE("Matches the reference loop")
+  {
+    for (int influences : {1, 3, 8})
+    {
+      // 4103 vertices, several blocks for the pool plus a scalar tail
+      const std::size_t n = 4103;
+      std::vector<Vec3> positions(n), normals(n), out_positions(n), out_normals(n);
+      std::vector<std::uint16_t> joints(n * influences);
+      std::vector<float> weights(n * influences);
+      for (std::size_t i = 0; i < n; i++)
+      {
+        positions[i] = Vec3(std::sin(0.1f * i), std::cos(0.3f * i), 0.01f * i);
+        normals[i] = Vec3(0.0f, std::cos(0.2f * i), std::sin(0.2f * i));
+        float sum = 0;
+        for (int k = 0; k < influences; k++)
+        {
+          joints[i * influences + k] = std::uint16_t((i + 2 * k) % palette.size());
+          weights[i * influences + k] = 1.0f + float((i + k) % 5);
+          sum += weights[i * influences + k];
+        }
+        for (int k = 0; k < influences; k++)
+          weights[i * influences + k] /= sum;
+      }
+
+      for (bool parallel : {false, true})
+      {
+        if (parallel)
+          skin_vertices(par.on(pool), palette, positions, normals, joints, weights, influences, out_positions, out_normals);
+        else
+          skin_vertices(palette, positions, normals, joints, weights, influences, out_positions, out_normals);
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+          // the hand-written loop the kernel replaces
+          Mat4 m = Mat4::zero;
+          for (int k = 0; k < influences; k++)
+            m += palette[joints[i * influences + k]] * weights[i * influences + k];
+          const Vec4 p = m * Vec4(positions[i].x, positions[i].y, positions[i].z, 1);
+          const Vec4 d = m * Vec4(normals[i].x, normals[i].y, normals[i].z, 0);
+          CHECK(approx_vec(out_positions[i], Vec3(p.x, p.y, p.z)));
+          CHECK(approx_vec(out_normals[i], Vec3(d.x, d.y, d.z)));
+        }
+      }
+    }
+  }
+
+  SUBCASE("Without normals")
+  {
+    const std::vector<Vec3> positions = {Vec3(1, 2, 3), Vec3(-1, 0, 1)};
+    const std::vector<std::uint16_t> joints = {2, 4};
+    const std::vector<float> weights = {1, 1};
+    std::vector<Vec3> out(2);
+    skin_vertices(palette, positions, {}, joints, weights, 1, out, {});
+    const Vec4 p = palette[4] * Vec4(-1, 0, 1, 1);
+    CHECK(approx_vec(out[1], Vec3(p.x, p.y, p.z)));
+  }
+}
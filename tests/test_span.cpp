@@ -0,0 +1,42 @@
+#include <ndv/mat.h>
+#include <ndv/quat.h>
+#include <ndv/span.h>
+using namespace ndv;
+
+#include <doctest/doctest.h>
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+TEST_CASE("Span byte view tests")
+{
+  static_assert(std::is_trivially_copyable_v<Vec3> && std::is_trivially_copyable_v<Vec4>);
+  static_assert(std::is_trivially_copyable_v<Mat4> && std::is_trivially_copyable_v<Quat>);
+
+  std::vector<Mat4> mats = {Mat4::identity, translate(Vec3(1, 2, 3)), scale(Vec3(2))};
+
+  SUBCASE("Round trip through bytes")
+  {
+    span<const std::byte> bytes = as_bytes(mats);
+    CHECK(bytes.size() == mats.size() * sizeof(Mat4));
+    CHECK(static_cast<const void*>(bytes.data()) == static_cast<const void*>(mats.data()));
+
+    std::vector<Mat4> uploaded(mats.size());
+    std::memcpy(as_writable_bytes(uploaded).data(), bytes.data(), bytes.size());
+
+    span<const Mat4> view = from_bytes<Mat4>(as_bytes(uploaded));
+    REQUIRE(view.size() == mats.size());
+    for (std::size_t i = 0; i < view.size(); i++)
+      CHECK(view[i] == mats[i]);
+  }
+
+  SUBCASE("Writable view")
+  {
+    std::vector<Quat> quats(2, Quat::identity);
+    span<Quat> view = from_writable_bytes<Quat>(as_writable_bytes(quats));
+    view[1] = Quat(0, Vec3(1, 0, 0));
+    CHECK(quats[1] == Quat(0, Vec3(1, 0, 0)));
+    CHECK(quats[0] == Quat::identity);
+  }
+}
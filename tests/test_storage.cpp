@@ -0,0 +1,122 @@
+#include <ndv/storage.h>
+using namespace ndv;
+
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+TEST_CASE("Storage scalar tests")
+{
+  SUBCASE("float16")
+  {
+    CHECK(float16(1.0f).bits == 0x3c00);
+    CHECK(float16(-2.0f).bits == 0xc000);
+    CHECK(float16(65504.0f).bits == 0x7bff);
+    CHECK(float16(1e6f).bits == 0x7c00);
+    CHECK(float16(5.9604645e-08f).bits == 0x0001); // smallest subnormal
+    CHECK(float16(1.0f + 1.0f / 4096).bits == 0x3c00); // ties round to even
+    CHECK(std::isnan(float(float16(std::numeric_limits<float>::quiet_NaN()))));
+
+    for (float f : {0.0f, 1.0f, -0.5f, 3.140625f, 65504.0f, 6.1035156e-05f, 5.9604645e-08f})
+      CHECK(float(float16(f)) == f);
+    CHECK(float(float16(0.1f)) == doctest::Approx(0.1f).epsilon(1e-3));
+  }
+
+  SUBCASE("Normalized integers")
+  {
+    CHECK(snorm16(1.0f).bits == 32767);
+    CHECK(snorm16(-2.0f).bits == -32767);
+    CHECK(float(snorm16(-1.0f)) == -1.0f);
+    CHECK(float(snorm16(0.25f)) == doctest::Approx(0.25f).epsilon(1e-4));
+    CHECK(unorm8(1.5f).bits == 255);
+    CHECK(unorm8(-1.0f).bits == 0);
+    CHECK(unorm8(0.5f).bits == 128);
+    CHECK(float(unorm8(1.0f)) == 1.0f);
+    CHECK(snorm16(std::numeric_limits<float>::quiet_NaN()).bits == 0);
+    CHECK(unorm8(std::numeric_limits<float>::quiet_NaN()).bits == 0);
+  }
+}
+
+TEST_CASE("Storage Vec tests")
+{
+  // 111 floats, which leaves a scalar remainder after the 4, 8 and 16 wide steps
+  std::vector<Vec3> v(37);
+  for (std::size_t i = 0; i < v.size(); i++)
+    v[i] = Vec3(std::sin(0.3f * i), std::cos(0.7f * i), 0.02f * i - 0.5f);
+
+  SUBCASE("Bulk round trips")
+  {
+    std::vector<Vec3h> h(v.size());
+    std::vector<Vec3snorm16> s(v.size());
+    std::vector<Vec3unorm8> u(v.size());
+    std::vector<Vec3> back_h(v.size()), back_s(v.size()), back_u(v.size());
+    pack(v, h);
+    pack(v, s);
+    pack(v, u);
+    unpack(h, back_h);
+    unpack(s, back_s);
+    unpack(u, back_u);
+
+    for (std::size_t i = 0; i < v.size(); i++)
+    {
+      for (int c = 0; c < 3; c++)
+      {
+        // bulk kernels agree with the scalar conversions bit for bit
+        CHECK(h[i][c].bits == float16(v[i][c]).bits);
+        CHECK(s[i][c].bits == snorm16(v[i][c]).bits);
+        CHECK(u[i][c].bits == unorm8(v[i][c]).bits);
+        CHECK(back_h[i][c] == float(h[i][c]));
+        CHECK(back_s[i][c] == float(s[i][c]));
+        CHECK(back_u[i][c] == float(u[i][c]));
+        CHECK(std::abs(back_h[i][c] - v[i][c]) <= 5e-4f);
+        CHECK(std::abs(back_s[i][c] - v[i][c]) <= 2e-5f);
+        CHECK(std::abs(back_u[i][c] - std::clamp(v[i][c], 0.0f, 1.0f)) <= 2e-3f);
+      }
+    }
+  }
+
+  SUBCASE("NaN and out of range")
+  {
+    // a NaN in a SIMD block and one in the scalar tail both pack to 0
+    const float nan = std::numeric_limits<float>::quiet_NaN(), inf = std::numeric_limits<float>::infinity();
+    const std::vector<float> in = {0.5f, -inf, nan, 2.0f, -0.25f, inf, -nan, 1.0f, -3.0f, nan, 0.0f};
+    std::vector<snorm16> s(in.size());
+    std::vector<unorm8> u(in.size());
+    pack(in, s);
+    pack(in, u);
+    for (std::size_t i = 0; i < in.size(); i++)
+    {
+      CHECK(s[i].bits == snorm16(in[i]).bits);
+      CHECK(u[i].bits == unorm8(in[i]).bits);
+    }
+    CHECK(s[2].bits == 0);
+    CHECK(s[6].bits == 0);
+    CHECK(s[9].bits == 0);
+    CHECK(u[9].bits == 0);
+  }
+
+  SUBCASE("Widening arithmetic")
+  {
+    const Vec3h a = narrow<float16>(Vec3(1.0f, 2.0f, -0.5f));
+    const Vec3h b = narrow<float16>(Vec3(0.5f, 0.25f, 4.0f));
+    const Vec3 f(1, 1, 1);
+
+    static_assert(std::is_same_v<decltype(a + b), Vec3>);
+    static_assert(std::is_same_v<decltype(2.0f * a), Vec3>);
+    CHECK(a + b == Vec3(1.5f, 2.25f, 3.5f));
+    CHECK(a * b == Vec3(0.5f, 0.5f, -2.0f));
+    CHECK(f - a == Vec3(0.0f, -1.0f, 1.5f));
+    CHECK(a / f == widen(a));
+    CHECK(2.0f * a == Vec3(2.0f, 4.0f, -1.0f));
+
+    Vec3 acc(0.0f);
+    acc += a;
+    acc += b;
+    CHECK(acc == Vec3(1.5f, 2.25f, 3.5f));
+
+    const Vec4unorm8 color = narrow<unorm8>(Vec4(1.0f, 0.0f, 0.5f, 1.0f));
+    CHECK((Vec4(1.0f) - color).z == doctest::Approx(127.0f / 255.0f));
+  }
+}
@@ -0,0 +1,18 @@
+#include <ndv/quat.h>
+#include <ndv/transform.h>
+#include <ndv/storage.h>
+using namespace ndv;
+
+#include <doctest/doctest.h>
+
+#include <cmath>
+
+TEST_CASE("Storage with the transform headers")
+{
+  // storage.h after quat.h, the order transform.h, pose.h and trs.h pull them in
+  const Quat q = Quat::axis_angle(Vec3(0, 0, 1), 1.0f);
+  const Vec3h p = narrow<float16>(Vec3(1.0f, 0.5f, -2.0f));
+  CHECK(half(q).w == doctest::Approx(std::cos(0.25f)));
+  CHECK(float16(1.0f).bits == 0x3c00);
+  CHECK(widen(p) == Vec3(1.0f, 0.5f, -2.0f));
+}
@@ -0,0 +1,125 @@
+#include <ndv/transform.h>
+using namespace ndv;
+
+#include <doctest/doctest.h>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Batch transform tests")
+{
+  std::vector<Vec3> points;
+  for (int i = 0; i < 7; i++)
+    points.push_back(Vec3(float(i), 1.0f - i, 0.5f * i));
+
+  SUBCASE("Affine points and directions")
+  {
+    Mat4 m = translate(Vec3(1, 2, 3));
+    m[0][0] = 2;
+
+    std::vector<Vec3> out(points.size());
+    transform_points(m, points, out);
+    for (std::size_t i = 0; i < points.size(); i++)
+      CHECK(out[i] == Vec3(2 * points[i].x + 1, points[i].y + 2, points[i].z + 3));
+
+    transform_directions(m, points, out);
+    for (std::size_t i = 0; i < points.size(); i++)
+      CHECK(out[i] == Vec3(2 * points[i].x, points[i].y, points[i].z));
+  }
+
+  SUBCASE("Projective points divide by w")
+  {
+    Mat4 m = Mat4::identity;
+    m[3][3] = 2;
+
+    std::vector<Vec3> out(points.size());
+    transform_points(m, points, out);
+    for (std::size_t i = 0; i < points.size(); i++)
+      CHECK(out[i] == points[i] / 2.0f);
+  }
+
+  SUBCASE("In place")
+  {
+    Mat4 m = translate(Vec3(1, 0, 0));
+    std::vector<Vec3> expected = points;
+    for (Vec3& p : expected)
+      p.x += 1;
+
+    transform_points(m, points, points);
+    for (std::size_t i = 0; i < points.size(); i++)
+      CHECK(points[i] == expected[i]);
+  }
+
+  SUBCASE("Homogeneous vectors")
+  {
+    Mat4 m = translate(Vec3(1, 2, 3));
+    std::vector<Vec4> v = {Vec4(1, 1, 1, 1), Vec4(1, 1, 1, 0), Vec4(0, 0, 0, 2)};
+    transform_vec4(m, v, v);
+    CHECK(v[0] == Vec4(2, 3, 4, 1));
+    CHECK(v[1] == Vec4(1, 1, 1, 0));
+    CHECK(v[2] == Vec4(2, 4, 6, 2));
+  }
+}
+
+TEST_CASE("Batch rotate tests")
+{
+  const Quat q = Quat::axis_angle(Vec3(0, 1, 1), 0.75f);
+  std::vector<Vec3> points;
+  for (int i = 0; i < 7; i++)
+    points.push_back(Vec3(float(i), 1.0f - i, 0.5f * i));
+
+  SUBCASE("AoS")
+  {
+    std::vector<Vec3> out(points.size());
+    rotate(points, q, out);
+    for (std::size_t i = 0; i < points.size(); i++)
+      CHECK(length(out[i] - rotate(points[i], q)) < 1e-5f);
+
+    rotate(points, q, points);
+    for (std::size_t i = 0; i < points.size(); i++)
+      CHECK(points[i] == out[i]);
+  }
+
+  SUBCASE("SoA")
+  {
+    Vec3Array soa(points), out;
+    rotate(soa, q, out);
+    REQUIRE(out.size() == points.size());
+    for (std::size_t i = 0; i < points.size(); i++)
+      CHECK(length(out[i].value() - rotate(points[i], q)) < 1e-5f);
+  }
+}
+
+TEST_CASE("Batch quat conversion tests")
+{
+  std::vector<Quat> quats;
+  for (int i = 0; i < 7; i++)
+    quats.push_back(Quat::axis_angle(Vec3(1.0f, float(i), 0.5f), 0.4f * i));
+
+  std::vector<Mat4> mats(quats.size());
+  to_mat4(quats, mats);
+  for (std::size_t i = 0; i < quats.size(); i++)
+  {
+    const Mat4 expected = to_mat4(quats[i]);
+    for (int r = 0; r < 4; r++)
+      CHECK(length(mats[i][r] - expected[r]) < 1e-6f);
+  }
+
+  std::vector<Mat3> mats3(quats.size());
+  to_mat3(quats, mats3);
+  for (std::size_t i = 0; i < quats.size(); i++)
+  {
+    const Mat3 expected = to_mat3(quats[i]);
+    for (int r = 0; r < 3; r++)
+      CHECK(length(mats3[i][r] - expected[r]) < 1e-6f);
+  }
+
+  std::vector<Quat> back(quats.size());
+  from_matrix(mats, back);
+  for (std::size_t i = 0; i < quats.size(); i++)
+    CHECK(std::abs(dot(back[i], quats[i])) == doctest::Approx(1.0f).epsilon(1e-5));
+
+  from_matrix(mats3, back);
+  for (std::size_t i = 0; i < quats.size(); i++)
+    CHECK(std::abs(dot(back[i], from_matrix(mats3[i]))) == doctest::Approx(1.0f).epsilon(1e-5));
+}
@@ -0,0 +1,72 @@
+#include <ndv/trs.h>
+using namespace ndv;
+
+#include <cmath>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "approx.h"
+
+TEST_CASE("TRS tests")
+{
+  const TRS a(Vec3(1, -2, 3), Quat::axis_angle(Vec3(1, 2, -0.5f), 0.8f), Vec3(2, 0.5f, 1.5f));
+  const TRS b(Vec3(-4, 0, 1), Quat::axis_angle(Vec3(0, 1, 1), -1.3f), Vec3(1, 1, 3));
+  const Mat4 ma = translate(a.translation) * to_mat4(a.rotation) * scale(a.scale);
+
+  SUBCASE("Compose and decompose")
+  {
+    CHECK(approx_mat(compose(a), ma));
+    CHECK(compose(TRS::identity) == Mat4::identity);
+    CHECK(to_mat4(compose_affine(a)) == compose(a));
+
+    const TRS d = decompose(ma);
+    CHECK(approx_vec(d.translation, a.translation));
+    CHECK(approx_rotation(d.rotation, a.rotation));
+    CHECK(approx_vec(d.scale, a.scale));
+
+    // a mirror comes back as a negative x scale
+    const Mat4 mirrored = ma * scale(Vec3(1, 1, -1));
+    const TRS m = decompose(mirrored);
+    CHECK(m.scale.x < 0);
+    CHECK(approx_mat(compose(m), mirrored));
+  }
+
+  SUBCASE("Interpolation")
+  {
+    const TRS start = interpolate_transform(a, b, 0), end = interpolate_transform(a, b, 1);
+    CHECK(approx_vec(start.translation, a.translation));
+    CHECK(approx_rotation(start.rotation, a.rotation));
+    CHECK(approx_rotation(end.rotation, b.rotation));
+    CHECK(approx_vec(end.scale, b.scale));
+
+    const TRS mid = interpolate_transform(a, b, 0.5f);
+    CHECK(approx_vec(mid.translation, Vec3(-1.5f, -1, 2)));
+    CHECK(approx_rotation(mid.rotation, slerp(a.rotation, b.rotation, 0.5f), 1e-4f));
+    CHECK(approx_vec(mid.scale, Vec3(1.5f, 0.75f, 2.25f)));
+  }
+
+  SUBCASE("Batched")
+  {
+    std::vector<TRS> in, other, out(9), blended(9);
+    std::vector<Mat4> matrices(9);
+    for (int i = 0; i < 9; i++)
+    {
+      in.emplace_back(Vec3(float(i), 1, -2), Quat::axis_angle(Vec3(1, float(i % 3), -0.5f), 0.3f * i), Vec3(1 + 0.1f * i, 0.5f, 2));
+      other.emplace_back(Vec3(0, float(i), 1), Quat::axis_angle(Vec3(0, 1, float(i)), -0.2f * i), Vec3(1));
+    }
+
+    compose(in, matrices);
+    decompose(matrices, out);
+    interpolate_transform(in, other, 0.25f, blended);
+    for (int i = 0; i < 9; i++)
+    {
+      const TRS single = interpolate_transform(in[i], other[i], 0.25f);
+      CHECK(approx_mat(matrices[i], compose(in[i])));
+      CHECK(approx_mat(compose(out[i]), matrices[i]));
+      CHECK(approx_vec(blended[i].translation, single.translation));
+      CHECK(approx_quat(blended[i].rotation, single.rotation));
+      CHECK(approx_vec(blended[i].scale, single.scale));
+    }
+  }
+}
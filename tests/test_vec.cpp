@@ -14,3 +14,72 @@ TEST_CASE("Vec template class tests")
     CHECK(v1.x == 2);
   }
 }
+
+TEST_CASE("Vec4 arithmetic tests")
+{
+  Vec4 a(1, 2, 3, 4);
+  Vec4 b(4, 3, 2, 1);
+
+  SUBCASE("Element-wise operators")
+  {
+    CHECK(a + b == Vec4(5));
+    CHECK(a - b == Vec4(-3, -1, 1, 3));
+    CHECK(a * b == Vec4(4, 6, 6, 4));
+    CHECK(a / b == Vec4(0.25f, 2.0f / 3.0f, 1.5f, 4));
+    CHECK(a * 2.0f == Vec4(2, 4, 6, 8));
+    CHECK(2.0f * a == Vec4(2, 4, 6, 8));
+    CHECK(a / 2.0f == Vec4(0.5f, 1, 1.5f, 2));
+    CHECK(-a == Vec4(-1, -2, -3, -4));
+    CHECK(a != b);
+  }
+
+  SUBCASE("Compound assignment")
+  {
+    Vec4 c = a;
+    c += b;
+    CHECK(c == Vec4(5));
+    c -= b;
+    CHECK(c == a);
+    c *= 2.0f;
+    CHECK(c.y == 4);
+    c /= Vec4(2);
+    CHECK(c == a);
+  }
+
+  SUBCASE("Utility methods")
+  {
+    CHECK(dot(a, b) == 20);
+    CHECK(length_squared(a) == 30);
+    CHECK(length(Vec4(2, 0, 0, 0)) == 2);
+    CHECK(distance(a, a) == 0);
+    CHECK(length(normalize(a)) == doctest::Approx(1.0f));
+    CHECK(normalize(Vec4(0, 3, 0, 0)) == Vec4(0, 1, 0, 0));
+  }
+
+  SUBCASE("Double precision")
+  {
+    Vec4d d(1, 2, 3, 4);
+    CHECK(dot(d, d) == 30);
+    CHECK(d + d == Vec4d(2, 4, 6, 8));
+    CHECK(normalize(Vec4d(0, 0, 5, 0)) == Vec4d(0, 0, 1, 0));
+  }
+}
+
+TEST_CASE("Vec constexpr tests")
+{
+  constexpr Vec3 a(1, 2, 3);
+  constexpr Vec3 b = Vec3::unit_x * 2.0f;
+  constexpr Vec3 c = cross(a, b) + a;
+  static_assert(dot(a, b) == 2);
+  static_assert(c == Vec3(1, 8, -1));
+  static_assert(c[1] == 8);
+
+  constexpr Vec4 v = Vec4(1, 2, 3, 4) * 2.0f - Vec4(1);
+  static_assert(v == Vec4(1, 3, 5, 7));
+  static_assert(length_squared(v) == 84);
+
+  constexpr Vec<5, int> n = Vec<5, int>(2) + Vec<5, int>({0, 1, 2, 3, 4});
+  static_assert(n[4] == 6 && length_squared(n) == 90);
+
+  CHECK(c.z == -1);
+}
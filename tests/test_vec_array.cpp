@@ -0,0 +1,82 @@
+#include <ndv/vec_array.h>
+using namespace ndv;
+
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("VecArray template class tests")
+{
+  std::vector<Vec3> aos = {Vec3(1, 2, 3), Vec3(0, 3, 4), Vec3(-1, 0, 0)};
+  Vec3Array a(aos);
+
+  SUBCASE("AoS conversion")
+  {
+    REQUIRE(a.size() == 3);
+    CHECK(a[1] == Vec3(0, 3, 4));
+    CHECK(a.stream(2)[0] == 3);
+
+    std::vector<Vec3> out(3);
+    a.store(out);
+    CHECK(out[0] == aos[0]);
+    CHECK(out[2] == aos[2]);
+  }
+
+  SUBCASE("Aligned streams")
+  {
+    for (int c = 0; c < 3; c++)
+      CHECK(reinterpret_cast<std::uintptr_t>(a.component(c)) % Vec3Array::alignment == 0);
+  }
+
+  SUBCASE("Element proxies")
+  {
+    a[0] = Vec3(4, 5, 6);
+    a[1] += Vec3(1);
+    a[2][1] = 7;
+    CHECK(a[0] == Vec3(4, 5, 6));
+    CHECK(a[1] == Vec3(1, 4, 5));
+    Vec3 v = a[2];
+    CHECK(v == Vec3(-1, 7, 0));
+  }
+
+  SUBCASE("Growth keeps contents")
+  {
+    for (int i = 0; i < 100; i++)
+      a.push_back(Vec3(float(i)));
+    CHECK(a.size() == 103);
+    CHECK(a[2] == Vec3(-1, 0, 0));
+    CHECK(a[102] == Vec3(99));
+  }
+
+  SUBCASE("Whole-array operators")
+  {
+    Vec3Array b = a + a;
+    CHECK(b[0] == Vec3(2, 4, 6));
+    b -= a;
+    CHECK(b[1] == a[1]);
+    b *= 3.0f;
+    CHECK(b[2] == Vec3(-3, 0, 0));
+    CHECK((b / a)[0] == Vec3(3));
+  }
+
+  SUBCASE("Utility methods")
+  {
+    std::vector<float> out(3);
+    dot(a, a, out);
+    CHECK(out[0] == 14);
+    length(a, out);
+    CHECK(out[1] == 5);
+    distance(a, a, out);
+    CHECK(out[2] == 0);
+
+    Vec3Array n = normalize(a);
+    CHECK(n[1] == Vec3(0, 0.6f, 0.8f));
+    CHECK(n[2] == Vec3(-1, 0, 0));
+
+    Vec3Array c = cross(a, n);
+    CHECK(length(Vec3(c[0]) - cross(aos[0], normalize(aos[0]))) == doctest::Approx(0));
+    cross(a, a, a);
+    CHECK(a[1] == Vec3(0));
+  }
+}